@@ -0,0 +1,361 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench.c
+ *
+ * Description: Runs the real Control.elf and HMI.elf under simavr, cycle by
+ *              cycle, with their UARTs cross-wired, a 24C16 on the Control
+ *              ECU TWI and the HMI keypad driven from a flow file. For every
+ *              flow it reports the cycles between the mark and the end
+ *              condition, the latency they stand for at 8MHz and the bytes
+ *              each ECU sent on the link in that window.
+ *
+ *              A flow with an expect line also checks the window length.
+ *              motor_timing measures the motor phase, which the firmware
+ *              times with its own 1ms tick; a wrong cycle count or clock
+ *              shows up there. Every flow types its password on the
+ *              emulated keypad, so a flow that times out points at PINB.
+ *
+ *              bench <Control.elf> <HMI.elf> <flow file>...
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <libgen.h>
+#include "bench.h"
+#include "sim_elf.h"
+#include "sim_io.h"
+#include "avr_ioport.h"
+#include "avr_uart.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* ATmega32 data space addresses of the keypad port (PORTB) */
+#define BENCH_PINB      0x36
+#define BENCH_DDRB      0x37
+#define BENCH_PORTB     0x38
+
+/* Keypad rows on PB0..PB3 and columns on PB4..PB7 (HMI/HMI/board_config.h) */
+#define KEYPAD_FIRST_COL_PIN    4
+#define KEYPAD_ENTER            13
+
+/* Makefile passes the pkg-config version of the simavr it links */
+#ifndef BENCH_SIMAVR_VERSION
+#define BENCH_SIMAVR_VERSION    "unknown"
+#endif
+
+typedef struct {
+    Bench_FlowType *flow;
+    avr_t *control;
+    avr_t *hmi;
+    Bench_EepromType eeprom;
+    uint16_t next_event;
+    avr_cycle_count_t mark_cycle;
+    avr_cycle_count_t end_cycle;
+    avr_cycle_count_t release_cycle;
+    int8_t key_row;             /* -1 while no key is held */
+    int8_t key_col;
+    uint8_t marked;
+    uint32_t hmi_bytes;         /* HMI -> Control */
+    uint32_t control_bytes;     /* Control -> HMI */
+    uint8_t replies;
+} Bench_RunType;
+
+/* Key code at each row/column, the inverse of KEYPAD_4x4_adjustKeyNumber */
+static const uint8_t Bench_keypadLayout[4][4] = {
+    { 7, 8, 9, '%' },
+    { 4, 5, 6, '*' },
+    { 1, 2, 3, '-' },
+    { KEYPAD_ENTER, 0, '=', '+' }
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static avr_t *Bench_loadMcu(const char *elf)
+{
+    elf_firmware_t firmware;
+    avr_t *avr;
+
+    memset(&firmware, 0, sizeof(firmware));
+    if (elf_read_firmware(elf, &firmware) != 0)
+    {
+        fprintf(stderr, "%s: cannot read firmware\n", elf);
+        exit(1);
+    }
+
+    /* Eclipse builds do not embed the .mmcu section */
+    strcpy(firmware.mmcu, BENCH_MCU);
+    firmware.frequency = BENCH_F_CPU;
+
+    avr = avr_make_mcu_by_name(firmware.mmcu);
+    if (avr == NULL)
+    {
+        fprintf(stderr, "simavr has no %s core\n", BENCH_MCU);
+        exit(1);
+    }
+    avr_init(avr);
+    avr_load_firmware(avr, &firmware);
+    return avr;
+}
+
+static void Bench_quietUart(avr_t *avr)
+{
+    uint32_t flags = 0;
+
+    /* Keep the link bytes off stdout */
+    avr_ioctl(avr, AVR_IOCTL_UART_GET_FLAGS('0'), &flags);
+    flags &= ~AVR_UART_FLAG_STDIO;
+    avr_ioctl(avr, AVR_IOCTL_UART_SET_FLAGS('0'), &flags);
+}
+
+static avr_irq_t *Bench_uartIrq(avr_t *avr, uint32_t irq)
+{
+    return avr_io_getirq(avr, AVR_IOCTL_UART_GETIRQ('0'), irq);
+}
+
+static avr_irq_t *Bench_pinIrq(avr_t *avr, char port, uint8_t pin)
+{
+    return avr_io_getirq(avr, AVR_IOCTL_IOPORT_GETIRQ(port), pin);
+}
+
+static void Bench_hmiSent(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    Bench_RunType *run = (Bench_RunType *)param;
+
+    (void)irq;
+    (void)value;
+    if (run->marked && !run->end_cycle)
+    {
+        run->hmi_bytes++;
+    }
+}
+
+static void Bench_controlSent(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    Bench_RunType *run = (Bench_RunType *)param;
+
+    (void)irq;
+    if (!run->marked || run->end_cycle)
+    {
+        return;
+    }
+    run->control_bytes++;
+    if (run->flow->end_kind == END_REPLY && (uint8_t)value == run->flow->end_value
+            && ++run->replies == run->flow->end_count)
+    {
+        run->end_cycle = run->control->cycle;
+    }
+}
+
+static void Bench_controlMarkPin(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    Bench_RunType *run = (Bench_RunType *)param;
+
+    (void)irq;
+    if (!run->marked && (uint8_t)(value != 0) == run->flow->mark_value)
+    {
+        run->marked = 1;
+        run->mark_cycle = run->control->cycle;
+    }
+}
+
+static void Bench_controlPin(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    Bench_RunType *run = (Bench_RunType *)param;
+
+    (void)irq;
+    if (run->marked && !run->end_cycle && (uint8_t)(value != 0) == run->flow->end_value)
+    {
+        run->end_cycle = run->control->cycle;
+    }
+}
+
+/*
+ * PINB as the keypad sees it: rows and columns have pull-ups, a held key
+ * pulls its column low while the firmware drives its row low.
+ */
+static uint8_t Bench_readKeypad(struct avr_t *avr, avr_io_addr_t addr, void *param)
+{
+    Bench_RunType *run = (Bench_RunType *)param;
+    uint8_t ddr = avr->data[BENCH_DDRB];
+    uint8_t port = avr->data[BENCH_PORTB];
+    uint8_t inputs = 0xFF;
+
+    if (run->key_row >= 0 && (ddr & (1 << run->key_row)) && !(port & (1 << run->key_row)))
+    {
+        inputs &= (uint8_t)~(1 << (KEYPAD_FIRST_COL_PIN + run->key_col));
+    }
+    avr->data[addr] = (uint8_t)((port & ddr) | (inputs & ~ddr));
+    return avr->data[addr];
+}
+
+static void Bench_pressKey(Bench_RunType *run, uint8_t key, avr_cycle_count_t now)
+{
+    int8_t row, col;
+
+    for (row = 0; row < 4; row++)
+    {
+        for (col = 0; col < 4; col++)
+        {
+            if (Bench_keypadLayout[row][col] == key)
+            {
+                run->key_row = row;
+                run->key_col = col;
+                run->release_cycle = now + BENCH_MS_TO_CYCLES(BENCH_KEY_HOLD_MS);
+                return;
+            }
+        }
+    }
+}
+
+static void Bench_applyEvents(Bench_RunType *run, avr_cycle_count_t now)
+{
+    Bench_EventType *event;
+
+    if (run->key_row >= 0 && now >= run->release_cycle)
+    {
+        run->key_row = -1;
+    }
+
+    while (run->next_event < run->flow->events_count
+            && run->flow->events[run->next_event].cycle <= now)
+    {
+        event = &run->flow->events[run->next_event++];
+        switch (event->kind)
+        {
+        case EVENT_KEY:
+            Bench_pressKey(run, event->value, now);
+            break;
+        case EVENT_PIN:
+            avr_raise_irq(Bench_pinIrq(run->control, event->port, event->pin), event->value);
+            break;
+        case EVENT_MARK:
+            run->marked = 1;
+            run->mark_cycle = now;
+            break;
+        }
+    }
+}
+
+/* Returns 0 when the flow reached its end condition */
+static int Bench_runFlow(Bench_FlowType *flow, const char *control_elf, const char *hmi_elf)
+{
+    Bench_RunType run;
+    avr_t *next;
+    avr_cycle_count_t now, start, window;
+    int state;
+    int result = 0;
+
+    memset(&run, 0, sizeof(run));
+    run.flow = flow;
+    run.key_row = -1;
+
+    run.control = Bench_loadMcu(control_elf);
+    run.hmi = Bench_loadMcu(hmi_elf);
+    Bench_quietUart(run.control);
+    Bench_quietUart(run.hmi);
+
+    /* Cross-wire the link and count its bytes */
+    avr_connect_irq(Bench_uartIrq(run.hmi, UART_IRQ_OUTPUT), Bench_uartIrq(run.control, UART_IRQ_INPUT));
+    avr_connect_irq(Bench_uartIrq(run.control, UART_IRQ_OUTPUT), Bench_uartIrq(run.hmi, UART_IRQ_INPUT));
+    avr_irq_register_notify(Bench_uartIrq(run.hmi, UART_IRQ_OUTPUT), Bench_hmiSent, &run);
+    avr_irq_register_notify(Bench_uartIrq(run.control, UART_IRQ_OUTPUT), Bench_controlSent, &run);
+
+    Bench_eepromAttach(&run.eeprom, run.control);
+    avr_register_io_read(run.hmi, BENCH_PINB, Bench_readKeypad, &run);
+    /* Registered first, so a mark and an end on the same pin see an edge in that order */
+    if (flow->mark_on_pin)
+    {
+        avr_irq_register_notify(Bench_pinIrq(run.control, flow->mark_port, flow->mark_pin), Bench_controlMarkPin, &run);
+    }
+    if (flow->end_kind == END_PIN)
+    {
+        avr_irq_register_notify(Bench_pinIrq(run.control, flow->end_port, flow->end_pin), Bench_controlPin, &run);
+    }
+
+    /* Both cores share one timeline, always advance the one that is behind */
+    while (!run.end_cycle)
+    {
+        next = (run.hmi->cycle <= run.control->cycle) ? run.hmi : run.control;
+        state = avr_run(next);
+        if (state == cpu_Done || state == cpu_Crashed)
+        {
+            fprintf(stderr, "%s: %s stopped\n", flow->name, (next == run.hmi) ? "HMI" : "Control");
+            result = 1;
+            break;
+        }
+
+        now = (run.hmi->cycle < run.control->cycle) ? run.hmi->cycle : run.control->cycle;
+        Bench_applyEvents(&run, now);
+
+        /* Before the mark the timeout runs from the last scripted event */
+        start = run.marked ? run.mark_cycle
+                : (flow->events_count ? flow->events[flow->events_count - 1].cycle : 0);
+        if (now > start && now - start > flow->timeout)
+        {
+            fprintf(stderr, "%s: timed out\n", flow->name);
+            result = 1;
+            break;
+        }
+    }
+
+    if (result == 0)
+    {
+        window = run.end_cycle - run.mark_cycle;
+        printf("%-20s %12llu %10.3f %8lu %8lu\n", flow->name, (unsigned long long)window,
+                (double)window * 1000.0 / BENCH_F_CPU,
+                (unsigned long)run.hmi_bytes, (unsigned long)run.control_bytes);
+        if ((flow->expect_min || flow->expect_max)
+                && (window < flow->expect_min || window > flow->expect_max))
+        {
+            fprintf(stderr, "%s: %.3f ms is outside the expected %.0f to %.0f ms\n", flow->name,
+                    (double)window * 1000.0 / BENCH_F_CPU,
+                    (double)flow->expect_min * 1000.0 / BENCH_F_CPU,
+                    (double)flow->expect_max * 1000.0 / BENCH_F_CPU);
+            result = 1;
+        }
+    }
+
+    avr_terminate(run.control);
+    avr_terminate(run.hmi);
+    return result;
+}
+
+/*******************************************************************************
+ *                           Main Function                                     *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    static Bench_FlowType flow;
+    char name[64];
+    int i, failures = 0;
+
+    if (argc < 4)
+    {
+        fprintf(stderr, "usage: %s <Control.elf> <HMI.elf> <flow>...\n", argv[0]);
+        return 2;
+    }
+
+    /* The run is only comparable with one from the same simulator and firmware */
+    printf("# simavr %s, %s, %s\n", BENCH_SIMAVR_VERSION, argv[1], argv[2]);
+    printf("%-20s %12s %10s %8s %8s\n", "flow", "cycles", "ms", "hmi->ctl", "ctl->hmi");
+    for (i = 3; i < argc; i++)
+    {
+        snprintf(name, sizeof(name), "%s", basename(argv[i]));
+        name[strcspn(name, ".")] = '\0';
+        flow.name = name;
+        Bench_loadFlow(&flow, argv[i]);
+        failures += Bench_runFlow(&flow, argv[1], argv[2]);
+    }
+    return failures ? 1 : 0;
+}
@@ -0,0 +1,103 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench.h
+ *
+ * Description: Shared declarations of the simavr benchmark that runs the
+ *              real Control.elf and HMI.elf against scripted flows.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef BENCH_H_
+#define BENCH_H_
+
+#include <stdint.h>
+#include "sim_avr.h"
+#include "cpu_clock.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BENCH_F_CPU             CPU_CLOCK_HZ    /* The firmware's clock */
+#define BENCH_MCU               "atmega32"
+
+#define BENCH_MAX_EVENTS        128
+
+/* Simulated time after which a flow that never reached its end is failed */
+#define BENCH_DEFAULT_TIMEOUT_MS    60000
+
+/* How long a scripted key stays pressed */
+#define BENCH_KEY_HOLD_MS       100
+
+#define BENCH_MS_TO_CYCLES(ms)  ((avr_cycle_count_t)(ms) * (BENCH_F_CPU / 1000))
+
+#define EEPROM_SIZE             2048
+#define EEPROM_PAGE_SIZE        16
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum {
+    EVENT_KEY,      /* HMI keypad press */
+    EVENT_PIN,      /* Control ECU input level */
+    EVENT_MARK      /* Start of the measured window */
+} Bench_EventKind;
+
+typedef struct {
+    avr_cycle_count_t cycle;
+    Bench_EventKind kind;
+    uint8_t value;      /* Key code or pin level */
+    char port;
+    uint8_t pin;
+} Bench_EventType;
+
+typedef enum {
+    END_PIN,        /* Control ECU output pin reaches a level */
+    END_REPLY       /* Control ECU sent a byte to the HMI for the n-th time */
+} Bench_EndKind;
+
+typedef struct {
+    const char *name;
+    Bench_EventType events[BENCH_MAX_EVENTS];
+    uint16_t events_count;
+    Bench_EndKind end_kind;
+    char end_port;
+    uint8_t end_pin;
+    uint8_t end_value;      /* Pin level or reply byte */
+    uint8_t end_count;
+    uint8_t mark_on_pin;    /* Window starts when a Control output reaches a level */
+    char mark_port;
+    uint8_t mark_pin;
+    uint8_t mark_value;
+    avr_cycle_count_t timeout;
+    avr_cycle_count_t expect_min;   /* Window length the flow must measure, 0 and 0: any */
+    avr_cycle_count_t expect_max;
+} Bench_FlowType;
+
+typedef struct {
+    avr_t *avr;
+    avr_irq_t *irq;         /* TWI_IRQ_OUTPUT / TWI_IRQ_INPUT pair of the part */
+    uint8_t memory[EEPROM_SIZE];
+    uint16_t address;
+    uint8_t selected;       /* Device address byte of the current transfer, 0 if idle */
+    uint8_t index;          /* Bytes written since the device address */
+    uint8_t written;
+    avr_cycle_count_t busy_until;
+} Bench_EepromType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Parse flows/<name>.flow, exits on a syntax error (bench_flow.c) */
+void Bench_loadFlow(Bench_FlowType *flow, const char *path);
+
+/* Attach an erased 24C16 to the TWI of avr (bench_eeprom.c) */
+void Bench_eepromAttach(Bench_EepromType *eeprom, avr_t *avr);
+
+#endif /* BENCH_H_ */
@@ -0,0 +1,130 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_eeprom.c
+ *
+ * Description: 24C16 I2C EEPROM part for simavr. Page writes wrap inside the
+ *              16-byte page and the device does not acknowledge its address
+ *              during the 5ms write cycle, so the ACK polling of
+ *              external_eeprom.c costs what it costs on the board.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <string.h>
+#include "bench.h"
+#include "sim_io.h"
+#include "avr_twi.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define EEPROM_DEVICE_TYPE      0xA0
+#define EEPROM_WRITE_CYCLE_US   5000
+
+static const char *Bench_eepromIrqNames[2] = {
+    [TWI_IRQ_INPUT]  = "8>eeprom.out",
+    [TWI_IRQ_OUTPUT] = "32<eeprom.in",
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Bench_eepromAck(Bench_EepromType *eeprom)
+{
+    avr_raise_irq(eeprom->irq + TWI_IRQ_INPUT,
+            avr_twi_irq_msg(TWI_COND_ACK, eeprom->selected, 1));
+}
+
+static void Bench_eepromBus(struct avr_irq_t *irq, uint32_t value, void *param)
+{
+    Bench_EepromType *eeprom = (Bench_EepromType *)param;
+    avr_twi_msg_irq_t v;
+    uint16_t page;
+
+    (void)irq;
+    v.u.v = value;
+
+    if (v.u.twi.msg & TWI_COND_STOP)
+    {
+        if (eeprom->selected && eeprom->written)
+        {
+            eeprom->busy_until = eeprom->avr->cycle
+                    + avr_usec_to_cycles(eeprom->avr, EEPROM_WRITE_CYCLE_US);
+        }
+        eeprom->selected = 0;
+        eeprom->written = 0;
+    }
+
+    if (v.u.twi.msg & TWI_COND_START)
+    {
+        eeprom->selected = 0;
+        eeprom->index = 0;
+        eeprom->written = 0;
+
+        /* Silent while the write cycle runs, the master sees SLA+W NACK */
+        if ((v.u.twi.addr & 0xF0) == EEPROM_DEVICE_TYPE && eeprom->avr->cycle >= eeprom->busy_until)
+        {
+            eeprom->selected = v.u.twi.addr;
+            if (!(v.u.twi.addr & 1))
+            {
+                /* Block select bits A8..A10 come with the device address */
+                eeprom->address = (uint16_t)((v.u.twi.addr & 0x0E) << 7);
+            }
+            Bench_eepromAck(eeprom);
+        }
+    }
+
+    if (!eeprom->selected)
+    {
+        return;
+    }
+
+    if (v.u.twi.msg & TWI_COND_WRITE)
+    {
+        Bench_eepromAck(eeprom);
+        if (eeprom->index == 0)
+        {
+            eeprom->address = (uint16_t)((eeprom->address & 0x0700) | v.u.twi.data);
+        }
+        else
+        {
+            /* The address counter rolls over inside the page */
+            page = eeprom->address & (uint16_t)~(EEPROM_PAGE_SIZE - 1);
+            eeprom->memory[eeprom->address] = v.u.twi.data;
+            eeprom->address = page | ((eeprom->address + 1) & (EEPROM_PAGE_SIZE - 1));
+            eeprom->written++;
+        }
+        eeprom->index++;
+    }
+
+    if (v.u.twi.msg & TWI_COND_READ)
+    {
+        avr_raise_irq(eeprom->irq + TWI_IRQ_INPUT,
+                avr_twi_irq_msg(TWI_COND_READ, eeprom->selected, eeprom->memory[eeprom->address]));
+        eeprom->address = (eeprom->address + 1) % EEPROM_SIZE;
+    }
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Bench_eepromAttach(Bench_EepromType *eeprom, avr_t *avr)
+{
+    memset(eeprom, 0, sizeof(*eeprom));
+    memset(eeprom->memory, 0xFF, sizeof(eeprom->memory));   /* Erased device */
+    eeprom->avr = avr;
+
+    eeprom->irq = avr_alloc_irq(&avr->irq_pool, 0, 2, Bench_eepromIrqNames);
+    avr_irq_register_notify(eeprom->irq + TWI_IRQ_OUTPUT, Bench_eepromBus, eeprom);
+
+    avr_connect_irq(eeprom->irq + TWI_IRQ_INPUT,
+            avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_INPUT));
+    avr_connect_irq(avr_io_getirq(avr, AVR_IOCTL_TWI_GETIRQ(0), TWI_IRQ_OUTPUT),
+            eeprom->irq + TWI_IRQ_OUTPUT);
+}
@@ -0,0 +1,188 @@
+/******************************************************************************
+ *
+ * Module: Benchmark
+ *
+ * File Name: bench_flow.c
+ *
+ * Description: Parser of the flow files. Timed lines use the syntax of the
+ *              host scenarios (Host/scenarios), times in simulated ms:
+ *
+ *                  <time> key <0-9 | + | - | * | % | = | enter>   HMI keypad
+ *                  <time> pin <port><pin> <0 | 1>                  Control input
+ *                  <time> mark                     measured window starts here
+ *
+ *              or the window starts at a Control output instead:
+ *
+ *                  mark pin <port><pin> <0 | 1>
+ *
+ *              and one end condition closes the window:
+ *
+ *                  end pin <port><pin> <0 | 1>     Control output reaches the level
+ *                  end reply <hex byte> [n]        Control sent the byte n times
+ *                  timeout <ms>
+ *                  expect <min ms> <max ms>        fail outside this window length
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include "bench.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define KEY_ENTER   13  /* Value KEYPAD_getPressedKey returns for ENTER */
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static int Bench_parseKey(const char *name, uint8_t *key)
+{
+    if (name[0] >= '0' && name[0] <= '9' && name[1] == '\0')
+    {
+        *key = (uint8_t)(name[0] - '0');
+    }
+    else if (strcmp(name, "enter") == 0)
+    {
+        *key = KEY_ENTER;
+    }
+    else if (strchr("+-*%=", name[0]) != NULL && name[1] == '\0')
+    {
+        *key = (uint8_t)name[0];
+    }
+    else
+    {
+        return 0;
+    }
+    return 1;
+}
+
+static int Bench_parsePin(const char *name, char *port, uint8_t *pin)
+{
+    if (name[0] < 'A' || name[0] > 'D' || name[1] < '0' || name[1] > '7' || name[2] != '\0')
+    {
+        return 0;
+    }
+    *port = name[0];
+    *pin = (uint8_t)(name[1] - '0');
+    return 1;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Bench_loadFlow(Bench_FlowType *flow, const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[128], word[4][16];
+    uint64_t time_ms, last_ms = 0;
+    unsigned line_no = 0;
+    Bench_EventType *event;
+    int fields, has_end = 0;
+
+    if (file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+    flow->events_count = 0;
+    flow->mark_on_pin = 0;
+    flow->timeout = BENCH_MS_TO_CYCLES(BENCH_DEFAULT_TIMEOUT_MS);
+    flow->expect_min = 0;
+    flow->expect_max = 0;
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line_no++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        fields = sscanf(line, "%15s %15s %15s %15s", word[0], word[1], word[2], word[3]);
+        if (fields <= 0)
+        {
+            continue;
+        }
+
+        if (strcmp(word[0], "end") == 0 && fields >= 3)
+        {
+            has_end = 1;
+            if (strcmp(word[1], "pin") == 0 && fields == 4
+                    && Bench_parsePin(word[2], &flow->end_port, &flow->end_pin))
+            {
+                flow->end_kind = END_PIN;
+                flow->end_value = (uint8_t)(word[3][0] == '1');
+                continue;
+            }
+            if (strcmp(word[1], "reply") == 0)
+            {
+                flow->end_kind = END_REPLY;
+                flow->end_value = (uint8_t)strtoul(word[2], NULL, 16);
+                flow->end_count = (uint8_t)((fields == 4) ? atoi(word[3]) : 1);
+                continue;
+            }
+        }
+        else if (strcmp(word[0], "mark") == 0 && fields == 4 && strcmp(word[1], "pin") == 0
+                && Bench_parsePin(word[2], &flow->mark_port, &flow->mark_pin))
+        {
+            flow->mark_on_pin = 1;
+            flow->mark_value = (uint8_t)(word[3][0] == '1');
+            continue;
+        }
+        else if (strcmp(word[0], "timeout") == 0 && fields == 2)
+        {
+            flow->timeout = BENCH_MS_TO_CYCLES(strtoull(word[1], NULL, 10));
+            continue;
+        }
+        else if (strcmp(word[0], "expect") == 0 && fields == 3)
+        {
+            flow->expect_min = BENCH_MS_TO_CYCLES(strtoull(word[1], NULL, 10));
+            flow->expect_max = BENCH_MS_TO_CYCLES(strtoull(word[2], NULL, 10));
+            continue;
+        }
+        else if (fields >= 2 && flow->events_count < BENCH_MAX_EVENTS)
+        {
+            time_ms = strtoull(word[0] + (word[0][0] == '+'), NULL, 10);
+            if (word[0][0] == '+')
+            {
+                time_ms += last_ms;
+            }
+            last_ms = time_ms;
+
+            event = &flow->events[flow->events_count];
+            event->cycle = BENCH_MS_TO_CYCLES(time_ms);
+            if (strcmp(word[1], "key") == 0 && fields == 3 && Bench_parseKey(word[2], &event->value))
+            {
+                event->kind = EVENT_KEY;
+                flow->events_count++;
+                continue;
+            }
+            if (strcmp(word[1], "pin") == 0 && fields == 4 && Bench_parsePin(word[2], &event->port, &event->pin))
+            {
+                event->kind = EVENT_PIN;
+                event->value = (uint8_t)(word[3][0] == '1');
+                flow->events_count++;
+                continue;
+            }
+            if (strcmp(word[1], "mark") == 0 && fields == 2)
+            {
+                event->kind = EVENT_MARK;
+                flow->events_count++;
+                continue;
+            }
+        }
+
+        fprintf(stderr, "%s:%u: bad line\n", path, line_no);
+        exit(1);
+    }
+    fclose(file);
+
+    if (!has_end)
+    {
+        fprintf(stderr, "%s: no end condition\n", path);
+        exit(1);
+    }
+}
@@ -0,0 +1,54 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../gpio.c \
+../idle.c \
+../lcd.c \
+../link.c \
+../pool.c \
+../profile.c \
+../protocol.c \
+../tick.c \
+../timer.c \
+../trace.c \
+../uart.c 
+
+OBJS += \
+./gpio.o \
+./idle.o \
+./lcd.o \
+./link.o \
+./pool.o \
+./profile.o \
+./protocol.o \
+./tick.o \
+./timer.o \
+./trace.o \
+./uart.o 
+
+C_DEPS += \
+./gpio.d \
+./idle.d \
+./lcd.d \
+./link.d \
+./pool.d \
+./profile.d \
+./protocol.d \
+./tick.d \
+./timer.d \
+./trace.d \
+./uart.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+%.o: ../%.c subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -0,0 +1,65 @@
+/******************************************************************************
+ *
+ * Module: Configuration
+ *
+ * File Name: config.h
+ *
+ * Description: Layout, defaults and limits of the site configuration. The
+ *              Control ECU keeps it in EEPROM (config_store.h) and sends it
+ *              to the HMI during the link set-up.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef CONFIG_H_
+#define CONFIG_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Bump when the layout changes, a stored block of another version is ignored */
+#define CONFIG_VERSION              2
+
+/* Password digits: 2 x PASSWORD_MAX_LENGTH must fit LINK_MAX_PAYLOAD */
+#define PASSWORD_MIN_LENGTH         4
+#define PASSWORD_MAX_LENGTH         8
+
+/* Defaults, used until a configuration is written */
+#define CONFIG_DEFAULT_LOCKING_TIME     1       /* Seconds the motor runs per direction */
+#define CONFIG_DEFAULT_LOCKOUT_TIME     3       /* First lockout in seconds, doubles per further failure */
+#define CONFIG_DEFAULT_MAX_ATTEMPTS     3       /* Failures before the first lockout */
+#define CONFIG_DEFAULT_PASSWORD_LENGTH  5
+#define CONFIG_DEFAULT_TWI_BIT_RATE     TWI_DEFAULT_BIT_RATE    /* twi.h, Control ECU only */
+#define CONFIG_DEFAULT_FASTEST_RATE     0       /* Index into LINK_BAUD_RATES */
+#define CONFIG_DEFAULT_DOOR_SETTLE_TIME 5       /* Tenths of a second the door must stay shut before relocking */
+#define CONFIG_DEFAULT_HELD_OPEN_TIME   30      /* Seconds the door may stand open before the alarm */
+
+/* Accepted ranges */
+#define CONFIG_MAX_LOCKING_TIME     10
+#define CONFIG_MAX_LOCKOUT_TIME     30
+#define CONFIG_MAX_ATTEMPTS         10
+#define CONFIG_MAX_DOOR_SETTLE_TIME 50
+#define CONFIG_MAX_HELD_OPEN_TIME   240
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Sent as is over the link, all fields are bytes */
+typedef struct {
+    uint8 version;
+    uint8 lockingTime;
+    uint8 lockoutTime;
+    uint8 maxAttempts;
+    uint8 passwordLength;   /* Digits of the next password set, the stored one keeps its own */
+    uint8 twiBitRate;       /* TWBR, at least TWI_DEFAULT_BIT_RATE (400kHz at F_CPU) */
+    uint8 fastestRate;      /* Fastest link rate the Control ECU accepts */
+    uint8 doorSettleTime;   /* Tenths of a second */
+    uint8 heldOpenTime;     /* Seconds */
+} Config_Type;
+
+#endif /* CONFIG_H_ */
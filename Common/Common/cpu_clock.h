@@ -0,0 +1,46 @@
+/******************************************************************************
+ *
+ * Module: CPU Clock
+ *
+ * File Name: cpu_clock.h
+ *
+ * Description: The CPU clock of both boards. Every timing value derived from
+ *              F_CPU takes it from here, so a new crystal is one change.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef CPU_CLOCK_H_
+#define CPU_CLOCK_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CPU_CLOCK_HZ            8000000UL
+
+/* Include before <util/delay.h>. A -DF_CPU left in a build must agree */
+#ifndef F_CPU
+#define F_CPU                   CPU_CLOCK_HZ
+#elif F_CPU != CPU_CLOCK_HZ
+#error "-DF_CPU differs from CPU_CLOCK_HZ, set the clock in cpu_clock.h only"
+#endif
+
+/*
+ * libCommon.a defines a symbol named after the clock it was compiled for.
+ * An application built for another clock refers to a different name, so a
+ * stale archive fails to link instead of running its timings off.
+ */
+#define CPU_CLOCK_SYMBOL_NAME(hz)       CpuClock_libraryBuiltFor_##hz
+#define CPU_CLOCK_SYMBOL_EXPAND(hz)     CPU_CLOCK_SYMBOL_NAME(hz)
+#define CPU_CLOCK_SYMBOL                CPU_CLOCK_SYMBOL_EXPAND(CPU_CLOCK_HZ)
+
+extern const uint8 CPU_CLOCK_SYMBOL;
+
+/* Call once from main, the volatile read keeps the reference through LTO */
+#define CPU_CLOCK_CHECK_LIBRARY()       ((void)*(volatile const uint8 *)&CPU_CLOCK_SYMBOL)
+
+#endif /* CPU_CLOCK_H_ */
@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Module: Event
+ *
+ * File Name: event.h
+ *
+ * Description: Header-only event flag group: up to eight flags an ISR sets to
+ *              wake the main loop, which takes and clears them together.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef EVENT_H_
+#define EVENT_H_
+
+#include "std_types.h"
+#include "idle.h"
+#include <avr/io.h> /* To save and restore SREG */
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* One bit per event, zero-initialised = nothing pending */
+typedef volatile uint8 Event_GroupType;
+
+/*******************************************************************************
+ *                       Inline Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Raise flags from an ISR. The read-modify-write is safe there because
+ * interrupts do not nest.
+ */
+static inline void Event_setFromIsr(Event_GroupType *group, uint8 flags)
+{
+    *group |= flags;
+}
+
+/*
+ * Description :
+ * Raise flags from the main loop, masking interrupts for the read-modify-write.
+ */
+static inline void Event_set(Event_GroupType *group, uint8 flags)
+{
+    uint8 sreg = SREG;
+
+    cli();
+    *group |= flags;
+    SREG = sreg;
+}
+
+/*
+ * Description :
+ * Return the pending flags in mask and clear them. A flag an ISR raises
+ * afterwards stays pending for the next call.
+ */
+static inline uint8 Event_take(Event_GroupType *group, uint8 mask)
+{
+    uint8 sreg = SREG;
+    uint8 taken;
+
+    /* Three instructions with interrupts off, so a flag set in between is not lost */
+    cli();
+    taken = *group & mask;
+    *group &= ~taken;
+    SREG = sreg;
+
+    return taken;
+}
+
+/*
+ * Description :
+ * Sleep until at least one flag in mask is pending, then take them as
+ * Event_take does. A flag raised just before the CPU sleeps is seen on the
+ * next wake-up, at most one tick late.
+ */
+static inline uint8 Event_wait(Event_GroupType *group, uint8 mask)
+{
+    while ((*group & mask) == 0)
+    {
+        Idle_sleep();
+    }
+    return Event_take(group, mask);
+}
+
+#endif /* EVENT_H_ */
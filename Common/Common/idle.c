@@ -0,0 +1,58 @@
+/******************************************************************************
+ *
+ * Module: Idle
+ *
+ * File Name: idle.c
+ *
+ * Description: Source file for the idle manager
+ *
+ * Idle mode stops only the CPU clock, so Timer2 (the tick), Timer0 (the
+ * motor PWM) and the UART keep running and wake-up takes no start-up delay.
+ * Power-save would stop Timer2 as well, because the boards have no 32kHz
+ * crystal for its asynchronous mode.
+ *
+ * The UART driver polls, so the receive interrupt is only enabled around a
+ * sleep. Its handler disables it again and leaves the byte in UDR.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "idle.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <avr/sleep.h>
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(USART_RXC_vect)
+{
+    UCSRB &= ~(1 << RXCIE);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Idle_init(void)
+{
+    ACSR |= (1 << ACD);
+    set_sleep_mode(SLEEP_MODE_IDLE);
+}
+
+void Idle_sleep(void)
+{
+    cli();
+    if (!(UCSRA & (1 << RXC)))
+    {
+        UCSRB |= (1 << RXCIE);
+        sleep_enable();
+        sei();
+        sleep_cpu();    /* The instruction after sei always runs, a wake-up between the test and here is not lost */
+        sleep_disable();
+        UCSRB &= ~(1 << RXCIE);
+    }
+    sei();
+}
@@ -0,0 +1,38 @@
+/******************************************************************************
+ *
+ * Module: Idle
+ *
+ * File Name: idle.h
+ *
+ * Description: Header file for the idle manager: sleeps the CPU while a main
+ *              loop has nothing to do
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef IDLE_H_
+#define IDLE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Select Idle sleep mode and switch off the unused analog comparator.
+ */
+void Idle_init(void);
+
+/*
+ * Description :
+ * Sleep until the next interrupt: the 1ms tick, a received UART byte or any
+ * other enabled source. Returns at once if a byte is already waiting. Global
+ * interrupts must be enabled and the tick running, or only UART data wakes
+ * the CPU.
+ */
+void Idle_sleep(void);
+
+#endif /* IDLE_H_ */
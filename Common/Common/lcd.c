@@ -10,11 +10,14 @@
  *
  *******************************************************************************/
 
+#include "cpu_clock.h" /* F_CPU for the delay functions */
 #include <util/delay.h> /* For the delay functions */
 #include "common_macros.h" /* For GET_BIT Macro */
 #include "lcd.h"
 #include "gpio.h"
+#include "profile.h" /* For the profiling probes */
 #include <stdlib.h>
+#include <avr/pgmspace.h> /* To read strings kept in flash */
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -67,6 +70,7 @@ void LCD_init(void)
  */
 void LCD_sendCommand(uint8 command)
 {
+	PROFILE_BEGIN(PROFILE_LCD_COMMAND);
 	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
 	_delay_ms(1); /* delay for processing Tas = 50ns */
 	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
@@ -99,6 +103,7 @@ void LCD_sendCommand(uint8 command)
 	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
 	_delay_ms(1); /* delay for processing Th = 13ns */
 #endif
+	PROFILE_END(PROFILE_LCD_COMMAND);
 }
 
 /*
@@ -107,6 +112,7 @@ void LCD_sendCommand(uint8 command)
  */
 void LCD_displayCharacter(uint8 data)
 {
+	PROFILE_BEGIN(PROFILE_LCD_CHARACTER);
 	GPIO_writePin(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_HIGH); /* Data Mode RS=1 */
 	_delay_ms(1); /* delay for processing Tas = 50ns */
 	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
@@ -139,6 +145,7 @@ void LCD_displayCharacter(uint8 data)
 	GPIO_writePin(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
 	_delay_ms(1); /* delay for processing Th = 13ns */
 #endif
+	PROFILE_END(PROFILE_LCD_CHARACTER);
 }
 
 /*
@@ -162,6 +169,20 @@ void LCD_displayString(const char *Str)
 	*********************************************************/
 }
 
+/*
+ * Description :
+ * Display a string stored in flash on the screen
+ */
+void LCD_displayString_P(const char *Str)
+{
+	char c;
+	while((c = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_displayCharacter(c);
+		Str++;
+	}
+}
+
 /*
  * Description :
  * Move the cursor to a specified row and column index on the screen
@@ -200,6 +221,16 @@ void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
 	LCD_displayString(Str); /* display the string */
 }
 
+/*
+ * Description :
+ * Display a string stored in flash in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString_P(Str); /* display the string */
+}
+
 /*
  * Description :
  * Display the required decimal value on the screen
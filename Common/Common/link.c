@@ -0,0 +1,269 @@
+/******************************************************************************
+ *
+ * Module: Link
+ *
+ * File Name: link.c
+ *
+ * Description: Source file for the serial link setup
+ *
+ * Negotiation, all at the base rate except the test:
+ *
+ *   HMI                                  Control
+ *   LINK_PROPOSE(rate)      ------->
+ *                           <-------     LINK_ACK (or LINK_NACK: try next)
+ *   -- both switch to the proposed rate --
+ *   each pattern byte       ------->
+ *                           <-------     the same byte
+ *   LINK_ACK                ------->
+ *                           <-------     LINK_ACK, rate kept
+ *
+ * A timeout or a wrong echo sends both sides back to the base rate: Control
+ * when it waits LINK_REPLY_TIMEOUT in vain, the HMI after LINK_FALLBACK_DELAY
+ * so Control is surely listening at the base rate again. Proposing
+ * LINK_BASE_RATE_INDEX ends the negotiation at the base rate.
+ *
+ * Afterwards every message is a frame (see link.h), so the HMI can have
+ * several requests in flight and the Control ECU can answer them and stream
+ * events in any order.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "link.h"
+#include "protocol.h"
+#include "uart.h"
+#include "tick.h"
+#include "trace.h"
+#include "idle.h"
+#include <avr/pgmspace.h> /* To keep the tables in flash */
+
+/*******************************************************************************
+ *                           Private Constants                                 *
+ *******************************************************************************/
+
+static const uint32 Link_baudRates[LINK_NUM_BAUD_RATES] PROGMEM = LINK_BAUD_RATES;
+
+/* The faster rates are checked when proposed, but both ECUs must reach the base rate */
+#if (UART_DIVISOR(LINK_BASE_BAUD_RATE) > UART_MAX_DIVISOR) \
+        || (UART_ERROR_PERMILLE(LINK_BASE_BAUD_RATE) > UART_MAX_BAUD_ERROR_PERMILLE)
+#error "LINK_BASE_BAUD_RATE cannot be reached at F_CPU"
+#endif
+static const uint8 Link_testPattern[LINK_TEST_PATTERN_SIZE] PROGMEM = LINK_TEST_PATTERN;
+
+#define LINK_BAUD_RATE(index)   pgm_read_dword(&Link_baudRates[index])
+#define LINK_PATTERN_BYTE(i)    pgm_read_byte(&Link_testPattern[i])
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Link_delay(uint16 ms)
+{
+    Tick_Type start = Tick_get();
+
+    while (!Tick_hasElapsed(start, ms))
+    {
+        Idle_sleep();
+    }
+}
+
+/* HMI side of the test at the current rate */
+static uint8 Link_testMaster(void)
+{
+    uint8 i, echo;
+
+    for (i = 0; i < LINK_TEST_PATTERN_SIZE; i++)
+    {
+        UART_sendByte(LINK_PATTERN_BYTE(i));
+        if (!Link_receiveByte(&echo, LINK_REPLY_TIMEOUT) || echo != LINK_PATTERN_BYTE(i))
+        {
+            return FALSE;
+        }
+    }
+
+    UART_sendByte(LINK_ACK);
+    return Link_receiveByte(&echo, LINK_REPLY_TIMEOUT) && (echo == LINK_ACK);
+}
+
+/* Control side of the test at the current rate */
+static uint8 Link_testSlave(void)
+{
+    uint8 i, data;
+
+    for (i = 0; i < LINK_TEST_PATTERN_SIZE; i++)
+    {
+        /* Echo whatever arrived, the HMI judges it */
+        if (!Link_receiveByte(&data, LINK_REPLY_TIMEOUT))
+        {
+            return FALSE;
+        }
+        UART_sendByte(data);
+    }
+
+    if (!Link_receiveByte(&data, LINK_REPLY_TIMEOUT) || data != LINK_ACK)
+    {
+        return FALSE;
+    }
+    UART_sendByte(LINK_ACK);
+    return TRUE;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 Link_receiveByte(uint8 *data, uint16 timeout_ms)
+{
+    Tick_Type start = Tick_get();
+
+    while (!UART_isByteAvailable())
+    {
+        if (Tick_hasElapsed(start, timeout_ms))
+        {
+            return FALSE;
+        }
+        Idle_sleep();   /* Wakes on the byte itself */
+    }
+    *data = UART_recieveByte();
+    return TRUE;
+}
+
+uint32 Link_negotiateMaster(void)
+{
+    uint8 index, reply;
+
+    for (index = 0; index < LINK_BASE_RATE_INDEX; index++)
+    {
+        UART_sendByte(LINK_PROPOSE(index));
+        if (!Link_receiveByte(&reply, LINK_REPLY_TIMEOUT))
+        {
+            return LINK_BASE_BAUD_RATE;  /* Control does not negotiate */
+        }
+        if (reply != LINK_ACK)
+        {
+            continue;
+        }
+
+        /* Control switches once its ACK has left, give it time before the first test byte */
+        if (UART_setBaudRate(LINK_BAUD_RATE(index)))
+        {
+            Link_delay(LINK_SWITCH_DELAY);
+            if (Link_testMaster())
+            {
+                TRACE(TRACE_LINK_RATE, index, 0);
+                return LINK_BAUD_RATE(index);
+            }
+        }
+
+        Link_delay(LINK_FALLBACK_DELAY);
+        UART_setBaudRate(LINK_BASE_BAUD_RATE);
+    }
+
+    /* Tell Control to stop listening for proposals */
+    UART_sendByte(LINK_PROPOSE(LINK_BASE_RATE_INDEX));
+    Link_receiveByte(&reply, LINK_REPLY_TIMEOUT);
+    return LINK_BASE_BAUD_RATE;
+}
+
+uint32 Link_negotiateSlave(uint8 fastest)
+{
+    uint8 index;
+
+    while (Link_receiveByte(&index, LINK_SETUP_TIMEOUT))
+    {
+        index -= LINK_PROPOSE(0);
+        if (index == LINK_BASE_RATE_INDEX)
+        {
+            UART_sendByte(LINK_ACK);
+            break;
+        }
+
+        if ((index > LINK_BASE_RATE_INDEX) || (index < fastest))   /* Unknown, or over the site's limit */
+        {
+            UART_sendByte(LINK_NACK);
+            continue;
+        }
+
+        /* The switch waits for the ACK to leave. If the rate is out of reach the test fails */
+        UART_sendByte(LINK_ACK);
+        if (!UART_setBaudRate(LINK_BAUD_RATE(index)))
+        {
+            continue;
+        }
+
+        if (Link_testSlave())
+        {
+            TRACE(TRACE_LINK_RATE, index, 0);
+            return LINK_BAUD_RATE(index);
+        }
+        UART_setBaudRate(LINK_BASE_BAUD_RATE);
+    }
+    return LINK_BASE_BAUD_RATE;
+}
+
+void Link_sendFrame(uint8 type, uint8 seq, const uint8 *payload, uint8 length)
+{
+    uint8 i;
+
+    UART_sendByte(type);
+    UART_sendByte(seq);
+    UART_sendByte(length);
+    for (i = 0; i < length; i++)
+    {
+        UART_sendByte(payload[i]);
+    }
+}
+
+void Link_discardPending(void)
+{
+    while (UART_isByteAvailable())
+    {
+        (void)UART_recieveByte();
+    }
+}
+
+Link_FrameStatus Link_pollFrame(Link_FrameType *frame)
+{
+    uint8 i;
+
+    if (!UART_isByteAvailable())
+    {
+        return LINK_FRAME_NONE;
+    }
+
+    frame->type = UART_recieveByte();
+    if (UART_hadFramingError())
+    {
+        return LINK_FRAME_FRAMING_ERROR;
+    }
+
+    frame->seq = 0;
+    frame->length = 0;
+    if (frame->type == LINK_SYNC_COMMAND)
+    {
+        return LINK_FRAME_READY;  /* Sent bare */
+    }
+
+    /* The rest of the frame follows back to back */
+    if (!Link_receiveByte(&frame->seq, LINK_REPLY_TIMEOUT)
+            || !Link_receiveByte(&frame->length, LINK_REPLY_TIMEOUT)
+            || frame->length > LINK_MAX_PAYLOAD)
+    {
+        return LINK_FRAME_DROPPED;
+    }
+    for (i = 0; i < frame->length; i++)
+    {
+        if (!Link_receiveByte(&frame->payload[i], LINK_REPLY_TIMEOUT))
+        {
+            return LINK_FRAME_DROPPED;
+        }
+    }
+
+    /* Handlers read the payload in place, so its size is checked once here */
+    if (!Protocol_isValidLength(frame->type, frame->length))
+    {
+        return LINK_FRAME_DROPPED;
+    }
+    return LINK_FRAME_READY;
+}
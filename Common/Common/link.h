@@ -0,0 +1,153 @@
+/******************************************************************************
+ *
+ * Module: Link
+ *
+ * File Name: link.h
+ *
+ * Description: Header file for the HMI <-> Control serial link: baud rate
+ *              negotiation, byte reception with a timeout and request/reply
+ *              framing
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef LINK_H_
+#define LINK_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Rates tried, fastest first. All are within 0.2% at 8MHz and 16MHz with
+ * U2X, a rate F_CPU cannot reach is skipped. The last one is the rate both
+ * ECUs boot at and fall back to.
+ */
+#define LINK_BAUD_RATES         { 500000UL, 250000UL, 76800UL, 38400UL, 9600UL }
+#define LINK_NUM_BAUD_RATES     5
+#define LINK_BASE_RATE_INDEX    (LINK_NUM_BAUD_RATES - 1)
+#define LINK_BASE_BAUD_RATE     9600UL
+
+/* Proposal of Link_baudRates[index], outside the command codes */
+#define LINK_PROPOSE(index)     (0xB0 + (index))
+
+/* Negotiation replies */
+#define LINK_ACK                0xA5
+#define LINK_NACK               0x5A
+
+/* Test pattern sent at a candidate rate: alternating, solid and nibble bits */
+#define LINK_TEST_PATTERN       { 0x55, 0xAA, 0x00, 0xFF, 0x33, 0xCC, 0x0F, 0xF0 }
+#define LINK_TEST_PATTERN_SIZE  8
+
+/* Timeouts in ms */
+#define LINK_REPLY_TIMEOUT      20      /* One reply or echo, rate independent */
+#define LINK_SETUP_TIMEOUT      200     /* Control waiting for the next proposal */
+#define LINK_FALLBACK_DELAY     (2 * LINK_REPLY_TIMEOUT)
+#define LINK_SWITCH_DELAY       2       /* HMI, after switching, before the first test byte */
+
+/*
+ * Link health, HMI side. A request is resent with its sequence number when
+ * the reply is late; Control answers a resent request from its reply cache
+ * instead of running it twice. While the HMI waits for events it sends a
+ * heartbeat request every LINK_HEARTBEAT_PERIOD. Silence past the retries or
+ * LINK_PEER_TIMEOUT re-runs the CMD_CHECK_INIT exchange and negotiation.
+ */
+#define LINK_REQUEST_TIMEOUT    100     /* Requests that write at most a lockout slot */
+#define LINK_MAX_RETRIES        2
+
+/*
+ * Requests that save a record are answered once it is on both EEPROMs, so
+ * their reply time grows with the record: 8.5 ms per internal EEPROM byte and
+ * 5 ms per 24C16 page, counting the page a misaligned block spills into.
+ * Resending earlier would land in the middle of the write, overrun the UART
+ * and leave payload bytes to be read as frame headers. The record sizes are
+ * data plus the generation and CRC trailer; storage.c checks them.
+ */
+#define LINK_EEPROM_BYTE_TIME   9
+#define LINK_EEPROM_PAGE_TIME   5
+#define LINK_WRITE_TIMEOUT(bytes) \
+    (LINK_REQUEST_TIMEOUT + (bytes) * LINK_EEPROM_BYTE_TIME + ((bytes) / 16 + 2) * LINK_EEPROM_PAGE_TIME)
+#define LINK_CREDENTIAL_RECORD  28
+#define LINK_CONFIG_RECORD      12
+#define LINK_HEARTBEAT_PERIOD   250
+#define LINK_PEER_TIMEOUT       (3 * LINK_HEARTBEAT_PERIOD)
+
+/*
+ * Frames after the negotiation: type, sequence number, payload length, then
+ * the payload. Replies and events carry the sequence number of the request
+ * they belong to. The one exception is LINK_SYNC_COMMAND (CMD_CHECK_INIT),
+ * sent bare at the base rate and read back as a frame with no payload.
+ */
+#define LINK_SYNC_COMMAND       0x07
+#define LINK_MAX_PAYLOAD        17      /* A configuration and the password that authorises it */
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct {
+    uint8 type;
+    uint8 seq;
+    uint8 length;
+    uint8 payload[LINK_MAX_PAYLOAD];
+} Link_FrameType;
+
+typedef enum {
+    LINK_FRAME_NONE,            /* Nothing received */
+    LINK_FRAME_READY,           /* A whole frame is in the buffer */
+    LINK_FRAME_DROPPED,         /* Timed out, or a type or length protocol.h does not allow */
+    LINK_FRAME_FRAMING_ERROR    /* First byte had a framing error: rate mismatch */
+} Link_FrameStatus;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Wait up to timeout_ms for a byte. Returns FALSE on timeout. Needs the tick.
+ */
+uint8 Link_receiveByte(uint8 *data, uint16 timeout_ms);
+
+/*
+ * Description :
+ * HMI side, called right after the CMD_CHECK_INIT reply: propose each rate
+ * from the fastest, keep the first one the test pattern passes at.
+ * Returns the baud rate in use afterwards.
+ */
+uint32 Link_negotiateMaster(void);
+
+/*
+ * Description :
+ * Control side, called right after sending the CMD_CHECK_INIT reply: answer
+ * the proposals and echo the test pattern. Rates faster than
+ * LINK_BAUD_RATES[fastest] are refused. Returns the baud rate in use.
+ */
+uint32 Link_negotiateSlave(uint8 fastest);
+
+/*
+ * Description :
+ * Send one frame. payload may be NULL_PTR when length is 0.
+ */
+void Link_sendFrame(uint8 type, uint8 seq, const uint8 *payload, uint8 length);
+
+/*
+ * Description :
+ * Drop every byte already received. For the HMI while it has no request
+ * outstanding: anything arriving then is stale, and an unread byte would keep
+ * Idle_sleep from sleeping.
+ */
+void Link_discardPending(void);
+
+/*
+ * Description :
+ * Returns LINK_FRAME_NONE at once when no byte is waiting. Otherwise reads a
+ * whole frame, allowing LINK_REPLY_TIMEOUT between its bytes. A READY frame
+ * has a type and payload length listed in protocol.h.
+ */
+Link_FrameStatus Link_pollFrame(Link_FrameType *frame);
+
+#endif /* LINK_H_ */
@@ -0,0 +1,132 @@
+/******************************************************************************
+ *
+ * Module: Pool
+ *
+ * File Name: pool.c
+ *
+ * Description: Source file for the fixed-block memory pools
+ *
+ * A freed block holds the index + 1 of the next free block in its first byte,
+ * so the free list costs no RAM. Blocks that were never used are handed out
+ * in order from the fresh mark first, which lets a zero-initialised pool work
+ * without a set-up loop.
+ *
+ * A bit per block records whether it is handed out. Pool_free checks it
+ * together with the bounds and alignment of the pointer, so a block freed
+ * twice can never be linked into the free list twice.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "pool.h"
+#include "link.h"
+#include "protocol.h"
+#include "trace.h"
+#include <avr/io.h> /* To save and restore SREG */
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static Pool_Type *g_pools = NULL_PTR;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Pool_init(Pool_Type *pool)
+{
+    pool->next = g_pools;
+    g_pools = pool;
+}
+
+void *Pool_alloc(Pool_Type *pool)
+{
+    uint8 sreg = SREG;
+    uint8 *block = NULL_PTR;
+    uint8 index = 0;
+
+    cli();
+    if (pool->freeHead != 0)
+    {
+        index = pool->freeHead - 1;
+        block = &pool->blocks[(uint16)index * pool->blockSize];
+        pool->freeHead = block[0];
+    }
+    else if (pool->fresh < pool->blockCount)
+    {
+        index = pool->fresh;
+        block = &pool->blocks[(uint16)index * pool->blockSize];
+        pool->fresh++;
+    }
+
+    if (block != NULL_PTR)
+    {
+        pool->used[index >> 3] |= (uint8)(1 << (index & 7));
+        pool->inUse++;
+        if (pool->inUse > pool->highWater)
+        {
+            pool->highWater = pool->inUse;
+        }
+    }
+    else if (pool->failures != 0xFF)
+    {
+        pool->failures++;
+    }
+    SREG = sreg;
+
+    return block;
+}
+
+uint8 Pool_free(Pool_Type *pool, void *block)
+{
+    uint8 sreg = SREG;
+    uintptr_t offset = (uintptr_t)block - (uintptr_t)pool->blocks; /* Wraps high below the blocks */
+    uint8 index = (uint8)(offset / pool->blockSize);
+    uint8 bit = (uint8)(1 << (index & 7));
+    uint8 freed = FALSE;
+
+    cli();
+    if ((offset < (uintptr_t)pool->blockCount * pool->blockSize)
+            && (offset % pool->blockSize == 0)
+            && (pool->used[index >> 3] & bit))
+    {
+        pool->used[index >> 3] &= (uint8)~bit;
+        ((uint8 *)block)[0] = pool->freeHead;
+        pool->freeHead = index + 1;
+        pool->inUse--;
+        freed = TRUE;
+    }
+    SREG = sreg;
+
+    if (!freed)
+    {
+        TRACE_FAULT_HOLD(TRACE_FAULT_POOL_FREE);
+    }
+    return freed;
+}
+
+void Pool_dump(uint8 seq)
+{
+    const Pool_Type *pool;
+    Protocol_PoolHeaderType header = { 0 };
+    RESPONSE_POOLS_PayloadType stats;
+
+    for (pool = g_pools; pool != NULL_PTR; pool = pool->next)
+    {
+        header.count++;
+    }
+
+    Link_sendFrame(RESPONSE_POOLS, seq, (const uint8 *)&header, sizeof(header));
+    for (pool = g_pools; pool != NULL_PTR; pool = pool->next)
+    {
+        stats.blockSize = pool->blockSize;
+        stats.blockCount = pool->blockCount;
+        stats.inUse = pool->inUse;
+        stats.highWater = pool->highWater;
+        stats.failures = pool->failures;
+        Link_sendFrame(RESPONSE_POOLS, seq, (const uint8 *)&stats, sizeof(stats));
+    }
+}
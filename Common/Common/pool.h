@@ -0,0 +1,102 @@
+/******************************************************************************
+ *
+ * Module: Pool
+ *
+ * File Name: pool.h
+ *
+ * Description: Header file for the fixed-block memory pools. Short-lived
+ *              buffers such as frames and events are taken from a pool of
+ *              equal blocks sized at compile time, never from the heap.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef POOL_H_
+#define POOL_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Block count limit: free blocks are chained by a one-byte index */
+#define POOL_MAX_BLOCKS         254
+
+/* Blocks are padded to the strictest alignment, 1 on the AVR */
+#define POOL_BLOCK_SIZE(size)   ((((size) + __BIGGEST_ALIGNMENT__ - 1) / __BIGGEST_ALIGNMENT__) * __BIGGEST_ALIGNMENT__)
+
+/*
+ * Define a pool of count blocks, each large enough for type:
+ *
+ *     POOL_DEFINE(g_framePool, Link_FrameType, 4);
+ *
+ *     Pool_init(&g_framePool);                     once, lists it for Pool_dump
+ *     frame = Pool_alloc(&g_framePool);            NULL_PTR when all are taken
+ *     Pool_free(&g_framePool, frame);
+ *
+ * Besides the blocks it reserves one bit per block, set while the block is
+ * handed out, which Pool_free checks.
+ */
+#define POOL_DEFINE(name, type, count)                                              \
+    static uint8 name##_blocks[(count) * POOL_BLOCK_SIZE(sizeof(type))]             \
+            __attribute__((aligned));                                               \
+    static uint8 name##_used[((count) + 7) / 8];                                    \
+    typedef char name##_sizeCheck[((count) > 0 && (count) <= POOL_MAX_BLOCKS        \
+            && POOL_BLOCK_SIZE(sizeof(type)) <= 0xFF) ? 1 : -1];                    \
+    Pool_Type name = { name##_blocks, name##_used, POOL_BLOCK_SIZE(sizeof(type)),   \
+            (count), 0, 0, 0, 0, 0, NULL_PTR }
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct Pool_Tag {
+    uint8 *blocks;
+    uint8 *used;            /* One bit per block, set while it is handed out */
+    uint8 blockSize;
+    uint8 blockCount;
+    uint8 freeHead;         /* Index + 1 of the first freed block, 0: none */
+    uint8 fresh;            /* Blocks from here on were never handed out */
+    uint8 inUse;
+    uint8 highWater;        /* Most blocks in use at once since reset */
+    uint8 failures;         /* Allocations refused because all were taken, saturates */
+    struct Pool_Tag *next;  /* Pools listed by Pool_init */
+} Pool_Type;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * List a pool for Pool_dump. Allocation works without it.
+ */
+void Pool_init(Pool_Type *pool);
+
+/*
+ * Description :
+ * Take a block, or NULL_PTR when all are in use. O(1), safe from ISRs and the
+ * main loop alike: interrupts are masked for a few instructions.
+ */
+void *Pool_alloc(Pool_Type *pool);
+
+/*
+ * Description :
+ * Give a block back, from any context. Returns FALSE and leaves the pool as
+ * it was if block is not the start of a block of this pool that is handed
+ * out: a foreign or misaligned pointer, or a block freed twice. Such a free
+ * is a bug, so it also stops the trace (TRACE_FAULT_POOL_FREE).
+ */
+uint8 Pool_free(Pool_Type *pool, void *block);
+
+/*
+ * Description :
+ * Send RESPONSE_POOLS frames with sequence number seq: a
+ * Protocol_PoolHeaderType with the number of listed pools, then one
+ * Protocol_PoolStatsType per pool, last listed first.
+ */
+void Pool_dump(uint8 seq);
+
+#endif /* POOL_H_ */
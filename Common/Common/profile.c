@@ -0,0 +1,139 @@
+/******************************************************************************
+ *
+ * Module: Profile
+ *
+ * File Name: profile.c
+ *
+ * Description: Source file for the cycle-counting profiling probes
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "profile.h"
+
+#if PROFILE_ENABLE
+
+#include "timer.h"
+#include "link.h"
+#include "protocol.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile uint16 g_overflows = 0;
+static Profile_EntryType g_profile[PROFILE_NUM_PROBES];
+
+TIMER_CLAIM(TIMER1);    /* Free-running cycle counter, only in profiling builds */
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Profile_overflowCallback(void)
+{
+    g_overflows++;
+}
+
+static void Profile_putWord(uint8 *bytes, uint32 value, uint8 size)
+{
+    while (size--)
+    {
+        *bytes++ = (uint8)value;
+        value >>= 8;
+    }
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Profile_init(void)
+{
+    Timer_ConfigType timerConfig = {
+            .initial_value = 0,
+            .compare_value = 0,
+            .timer_id = TIMER1_ID,
+            .mode = TIMER_MODE_NORMAL,
+            .prescaler = TIMER_PRESCALER_1  /* One count per CPU cycle */
+    };
+    uint8 i;
+
+    for (i = 0; i < PROFILE_NUM_PROBES; i++)
+    {
+        g_profile[i].min = 0xFFFFFFFFUL;
+        g_profile[i].max = 0;
+        g_profile[i].sum = 0;
+        g_profile[i].count = 0;
+    }
+
+    g_overflows = 0;
+    Timer_setCallBack_OVF(Profile_overflowCallback, TIMER1_ID);
+    Timer_init(&timerConfig);
+}
+
+uint32 Profile_cycles(void)
+{
+    uint16 low, high;
+    uint8 sreg = SREG;
+
+    cli();
+    low = TCNT1;
+    high = g_overflows;
+
+    /* The counter wrapped after cli(), its overflow is still pending */
+    if ((TIFR & (1 << TOV1)) && (low < 0x8000U))
+    {
+        high++;
+    }
+    SREG = sreg;
+
+    return ((uint32)high << 16) | low;
+}
+
+void Profile_begin(Profile_ProbeType probe)
+{
+    g_profile[probe].start = Profile_cycles();
+}
+
+void Profile_end(Profile_ProbeType probe)
+{
+    Profile_EntryType *entry = &g_profile[probe];
+    uint32 cycles = Profile_cycles() - entry->start;
+
+    if (cycles < entry->min)
+    {
+        entry->min = cycles;
+    }
+    if (cycles > entry->max)
+    {
+        entry->max = cycles;
+    }
+    entry->sum = (entry->sum > PROFILE_SUM_MAX - cycles) ? PROFILE_SUM_MAX : entry->sum + cycles;
+    if (entry->count < PROFILE_COUNT_MAX)
+    {
+        entry->count++;
+    }
+}
+
+void Profile_dump(uint8 seq)
+{
+    Protocol_ProfileHeaderType header = { PROFILE_NUM_PROBES };
+    RESPONSE_PROFILE_PayloadType probe;
+    uint8 i;
+
+    Link_sendFrame(RESPONSE_PROFILE, seq, (const uint8 *)&header, sizeof(header));
+    for (i = 0; i < PROFILE_NUM_PROBES; i++)
+    {
+        Profile_putWord(probe.count, g_profile[i].count, sizeof(probe.count));
+        Profile_putWord(probe.min, g_profile[i].min, sizeof(probe.min));
+        Profile_putWord(probe.max, g_profile[i].max, sizeof(probe.max));
+        Profile_putWord(probe.sum, g_profile[i].sum, sizeof(probe.sum));
+        Link_sendFrame(RESPONSE_PROFILE, seq, (const uint8 *)&probe, sizeof(probe));
+    }
+}
+
+#endif /* PROFILE_ENABLE */
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *
+ * Module: Profile
+ *
+ * File Name: profile.h
+ *
+ * Description: Header file for the cycle-counting profiling probes
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef PROFILE_H_
+#define PROFILE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * 1: build the probes in. The value is shared by libCommon.a and both
+ * applications, so it is set here and not per project. Profiling takes
+ * Timer1 as a free-running counter at the CPU clock.
+ */
+#ifndef PROFILE_ENABLE
+#define PROFILE_ENABLE          0
+#endif
+
+/* Count and sum stop here instead of wrapping */
+#define PROFILE_COUNT_MAX       0xFFFFU
+#define PROFILE_SUM_MAX         0xFFFFFFFFUL
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* One entry per probe point, the dump sends them in this order */
+typedef enum {
+    PROFILE_VERIFY_PASSWORD,
+    PROFILE_EEPROM_READ_PASSWORD,
+    PROFILE_DOOR_SEQUENCE,
+    PROFILE_TWI_START,
+    PROFILE_TWI_STOP,
+    PROFILE_TWI_WRITE,
+    PROFILE_TWI_READ,
+    PROFILE_LCD_COMMAND,
+    PROFILE_LCD_CHARACTER,
+    PROFILE_NUM_PROBES
+} Profile_ProbeType;
+
+typedef struct {
+    uint32 start;       /* Counter at the open Profile_begin */
+    uint32 min;         /* Cycles, 0xFFFFFFFF until the first sample */
+    uint32 max;
+    uint32 sum;
+    uint16 count;
+} Profile_EntryType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if PROFILE_ENABLE
+
+/*
+ * Description :
+ * Clear the table and start Timer1 counting CPU cycles, overflows extend it to 32 bits.
+ */
+void Profile_init(void);
+
+/*
+ * Description :
+ * CPU cycles since Profile_init, wraps after 2^32 / F_CPU seconds (~536s at 8MHz).
+ */
+uint32 Profile_cycles(void);
+
+/*
+ * Description :
+ * Open and close a probe. A probe must not be nested inside itself.
+ */
+void Profile_begin(Profile_ProbeType probe);
+void Profile_end(Profile_ProbeType probe);
+
+/*
+ * Description :
+ * Send RESPONSE_PROFILE frames with sequence number seq: a
+ * Protocol_ProfileHeaderType with PROFILE_NUM_PROBES, then one
+ * Protocol_ProfileProbeType per probe in Profile_ProbeType order. A peer ECU
+ * ignores these frames, so the dump can go out on the live link.
+ */
+void Profile_dump(uint8 seq);
+
+#define PROFILE_BEGIN(probe)    Profile_begin(probe)
+#define PROFILE_END(probe)      Profile_end(probe)
+
+#else
+
+#define PROFILE_BEGIN(probe)    ((void)0)
+#define PROFILE_END(probe)      ((void)0)
+
+#endif /* PROFILE_ENABLE */
+
+#endif /* PROFILE_H_ */
@@ -0,0 +1,52 @@
+/******************************************************************************
+ *
+ * Module: Protocol
+ *
+ * File Name: protocol.c
+ *
+ * Description: Source file for the frame length check and the payload size
+ *              checks generated from the message tables
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "protocol.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Written as ">= 0" would warn for the zero minimums, compare on int */
+#define PROTOCOL_LENGTH_CASE(name, code, payload, minLength)            \
+    case (code):                                                        \
+        return ((int)length >= (int)(minLength)) && (length <= sizeof(payload));
+
+#define PROTOCOL_SIZE_CHECK(name, code, payload, minLength)                                         \
+    _Static_assert(sizeof(payload) <= LINK_MAX_PAYLOAD, #name ": payload longer than a frame holds"); \
+    _Static_assert((minLength) <= sizeof(payload), #name ": minimum length above the payload size");
+
+/*******************************************************************************
+ *                              Size Checks                                    *
+ *******************************************************************************/
+
+PROTOCOL_COMMANDS(PROTOCOL_SIZE_CHECK)
+PROTOCOL_RESPONSES(PROTOCOL_SIZE_CHECK)
+PROTOCOL_EVENTS(PROTOCOL_SIZE_CHECK)
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 Protocol_isValidLength(uint8 type, uint8 length)
+{
+    /* A switch over the codes: GCC turns it into a jump table, a duplicate code is a build error */
+    switch (type)
+    {
+    PROTOCOL_COMMANDS(PROTOCOL_LENGTH_CASE)
+    PROTOCOL_RESPONSES(PROTOCOL_LENGTH_CASE)
+    PROTOCOL_EVENTS(PROTOCOL_LENGTH_CASE)
+    default:
+        return FALSE;
+    }
+}
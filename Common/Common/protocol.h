@@ -0,0 +1,217 @@
+/******************************************************************************
+ *
+ * Module: Protocol
+ *
+ * File Name: protocol.h
+ *
+ * Description: The one description of the frames the ECUs exchange (framing
+ *              in link.h). Both applications and the host tools take their
+ *              codes, payload layouts and length limits from here.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+#include "std_types.h"
+#include "config.h"
+#include "link.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/*
+ * Payload layouts. Bytes only, so a received payload is read in place
+ * through the type the table below gives its message:
+ *
+ *     const CMD_DIGIT_PayloadType *digit = (const CMD_DIGIT_PayloadType *)frame.payload;
+ */
+typedef struct {
+    uint8 none[0];          /* No payload, sizeof is 0 */
+} Protocol_NoneType;
+
+typedef struct {
+    uint8 digits[PASSWORD_MAX_LENGTH];
+} Protocol_PasswordType;
+
+/* The password, then its confirmation of the same length */
+typedef struct {
+    uint8 digits[2 * PASSWORD_MAX_LENGTH];
+} Protocol_PasswordPairType;
+
+typedef struct {
+    uint8 index;            /* Position in the password, from 0 */
+    uint8 digit;
+} Protocol_DigitType;
+
+/* The new configuration, then the stored password, whose length is the rest */
+typedef struct {
+    Config_Type config;
+    uint8 password[PASSWORD_MAX_LENGTH];
+} Protocol_SetConfigType;
+
+typedef struct {
+    uint8 cycles[4];        /* LSB first */
+} Protocol_CyclesType;
+
+typedef struct {
+    uint8 seconds;          /* Lockout time left */
+} Protocol_LockedType;
+
+typedef struct {
+    uint8 doorState;
+    uint8 lockoutSeconds;
+} Protocol_StatusType;
+
+typedef struct {
+    Config_Type config;
+    uint8 storedLength;     /* Digits of the stored password, 0: none */
+} Protocol_ConfigReplyType;
+
+/* First RESPONSE_TRACE frame of a dump, the records follow in the next ones */
+typedef struct {
+    uint8 count;            /* Records in the dump */
+    uint8 totalLow;         /* Records ever written, LSB first */
+    uint8 totalHigh;
+} Protocol_TraceHeaderType;
+
+#define PROTOCOL_TRACE_RECORD_SIZE  5   /* Time (LSB first), event, arg0, arg1 */
+#define PROTOCOL_TRACE_RECORDS      3   /* Records per frame, within LINK_MAX_PAYLOAD */
+
+/* Later RESPONSE_TRACE frames, as many whole records as there are left */
+typedef struct {
+    uint8 records[PROTOCOL_TRACE_RECORDS * PROTOCOL_TRACE_RECORD_SIZE];
+} Protocol_TraceRecordsType;
+
+/* First RESPONSE_POOLS frame of a dump, then one frame per listed pool */
+typedef struct {
+    uint8 count;            /* Pools in the dump */
+} Protocol_PoolHeaderType;
+
+typedef struct {
+    uint8 blockSize;
+    uint8 blockCount;
+    uint8 inUse;
+    uint8 highWater;
+    uint8 failures;         /* Refused allocations, saturates */
+} Protocol_PoolStatsType;
+
+/* First RESPONSE_PROFILE frame of a dump, then one frame per probe */
+typedef struct {
+    uint8 count;            /* Probes in the dump */
+} Protocol_ProfileHeaderType;
+
+/* All little-endian, in cycles */
+typedef struct {
+    uint8 count[2];         /* Samples, saturates */
+    uint8 min[4];
+    uint8 max[4];
+    uint8 sum[4];           /* Saturates */
+} Protocol_ProfileProbeType;
+
+/* First RESPONSE_AUDIT frame of an export, the records follow in the next ones */
+typedef struct {
+    uint8 count;            /* Records in the export */
+} Protocol_AuditHeaderType;
+
+#define PROTOCOL_AUDIT_RECORD_SIZE  8   /* AuditLog_RecordType as stored, see audit_log.h */
+#define PROTOCOL_AUDIT_RECORDS      2   /* Records per frame, within LINK_MAX_PAYLOAD */
+
+/* Later RESPONSE_AUDIT frames, oldest record first */
+typedef struct {
+    uint8 records[PROTOCOL_AUDIT_RECORDS * PROTOCOL_AUDIT_RECORD_SIZE];
+} Protocol_AuditRecordsType;
+
+/*******************************************************************************
+ *                              Message Tables                                 *
+ *******************************************************************************/
+/*
+ * X(name, code, payload type, minimum payload length)
+ *
+ * The longest payload a message may have is the size of its payload type, so
+ * the length check and the layout handlers read cannot disagree. protocol.c
+ * checks every payload type fits LINK_MAX_PAYLOAD and is no shorter than its
+ * minimum, and each message gets its type as <name>_PayloadType.
+ *
+ * Every code must be unique across the three tables: protocol.c switches on
+ * all of them, so a duplicate fails the build. A frame whose type is not
+ * listed or whose length is outside the limits is dropped by Link_pollFrame.
+ */
+
+/*---- HMI and debug tool requests; HMI codes are below CMD_CHECK_INIT, debug codes above ----*/
+#define PROTOCOL_COMMANDS(X)                                                                \
+    X(CMD_CREATE_PASSWORD, 0x01,              Protocol_PasswordPairType, 2 * PASSWORD_MIN_LENGTH) /* Also the second step of a change */ \
+    X(CMD_DIGIT,           0x02,              Protocol_DigitType,        sizeof(Protocol_DigitType)) /* Typed digit, no reply */ \
+    X(CMD_OPEN_DOOR,       0x03,              Protocol_PasswordType,     PASSWORD_MIN_LENGTH) /* Progress follows as events */ \
+    X(CMD_CHANGE_PASSWORD, 0x04,              Protocol_PasswordType,     PASSWORD_MIN_LENGTH) /* Old password */ \
+    X(CMD_STATUS,          0x05,              Protocol_NoneType,         0)                 /* Answered at any time, also while the door moves */ \
+    X(CMD_HEARTBEAT,       0x06,              Protocol_NoneType,         0)                 /* Answered with RESPONSE_OK */ \
+    X(CMD_CHECK_INIT,      LINK_SYNC_COMMAND, Protocol_NoneType,         0)                 /* Sent bare, see link.h */ \
+    X(CMD_EXPORT_LOG,      0x08,              Protocol_NoneType,         0)                 /* Answered a frame per idle pass, see audit_log.h */ \
+    X(CMD_GET_CONFIG,      0x09,              Protocol_NoneType,         0)                 /* Also sent by the HMI right after the rate negotiation */ \
+    X(CMD_SET_CONFIG,      0x0A,              Protocol_SetConfigType,    sizeof(Config_Type) + PASSWORD_MIN_LENGTH) /* Only after CMD_CHECK_INIT, verified like CMD_CHANGE_PASSWORD */ \
+    X(CMD_HASH_BENCHMARK,  0x10,              Protocol_PasswordType,     PASSWORD_MIN_LENGTH) /* Candidate password */ \
+    X(CMD_DUMP_PROFILE,    0x11,              Protocol_NoneType,         0)                 /* Profiling builds only, see profile.h */ \
+    X(CMD_DUMP_TRACE,      0x12,              Protocol_NoneType,         0)                 /* Tracing builds only, see trace.h */ \
+    X(CMD_DUMP_POOLS,      0x13,              Protocol_NoneType,         0)                 /* Block pool usage, see pool.h */
+
+/*---- Control ECU replies, one per request with its sequence number ----*/
+#define PROTOCOL_RESPONSES(X)                                                               \
+    X(RESPONSE_OK,         0xAA,              Protocol_CyclesType,       0)                 /* Cycles only for CMD_HASH_BENCHMARK */ \
+    X(RESPONSE_ERROR,      0xFF,              Protocol_NoneType,         0)                 \
+    X(RESPONSE_LOCKED,     0x77,              Protocol_LockedType,       sizeof(Protocol_LockedType)) \
+    X(RESPONSE_BUSY,       0x88,              Protocol_NoneType,         0)                 /* The door is still moving */ \
+    X(RESPONSE_STATUS,     0x99,              Protocol_StatusType,       sizeof(Protocol_StatusType)) \
+    X(RESPONSE_CONFIG,     0x9A,              Protocol_ConfigReplyType,  sizeof(Protocol_ConfigReplyType)) \
+    X(RESPONSE_TRACE,      0x9B,              Protocol_TraceRecordsType, sizeof(Protocol_TraceHeaderType)) /* Trace dump, see trace.h */ \
+    X(RESPONSE_POOLS,      0x9C,              Protocol_PoolStatsType,    sizeof(Protocol_PoolHeaderType)) /* Pool dump, see pool.h */ \
+    X(RESPONSE_PROFILE,    0x9D,              Protocol_ProfileProbeType, sizeof(Protocol_ProfileHeaderType)) /* Profile dump, see profile.h */ \
+    X(RESPONSE_AUDIT,      0x9E,              Protocol_AuditRecordsType, sizeof(Protocol_AuditHeaderType)) /* Audit log export, see audit_log.h */ \
+    X(RESPONSE_RESYNC,     0xCC,              Protocol_NoneType,         0)                 /* No CMD_CHECK_INIT since reset, the HMI must set the link up */
+
+/*---- Door progress, with the sequence number of the CMD_OPEN_DOOR ----*/
+#define PROTOCOL_EVENTS(X)                                                                  \
+    X(EVENT_UNLOCKING,     0x30,              Protocol_NoneType,         0)                 \
+    X(EVENT_PIR_HOLD,      0x31,              Protocol_NoneType,         0)                 \
+    X(EVENT_LOCKING,       0x32,              Protocol_NoneType,         0)                 \
+    X(EVENT_LOCKED,        0x33,              Protocol_NoneType,         0)                 \
+    X(EVENT_DOOR_OPEN,     0x34,              Protocol_NoneType,         0)                 /* Reed switch opened */ \
+    X(EVENT_DOOR_HELD,     0x35,              Protocol_NoneType,         0)                 /* Open too long, alarm on until it closes */
+
+/*******************************************************************************
+ *                      Generated Types                                        *
+ *******************************************************************************/
+
+#define PROTOCOL_ENUM_ENTRY(name, code, payload, minLength)     name = (code),
+#define PROTOCOL_PAYLOAD_TYPEDEF(name, code, payload, minLength) typedef payload name##_PayloadType;
+
+typedef enum {
+    PROTOCOL_COMMANDS(PROTOCOL_ENUM_ENTRY)
+} UART_Command;
+
+typedef enum {
+    PROTOCOL_RESPONSES(PROTOCOL_ENUM_ENTRY)
+} UART_Response;
+
+typedef enum {
+    PROTOCOL_EVENTS(PROTOCOL_ENUM_ENTRY)
+} UART_Event;
+
+PROTOCOL_COMMANDS(PROTOCOL_PAYLOAD_TYPEDEF)
+PROTOCOL_RESPONSES(PROTOCOL_PAYLOAD_TYPEDEF)
+PROTOCOL_EVENTS(PROTOCOL_PAYLOAD_TYPEDEF)
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * TRUE if type is a listed code and length is within its limits.
+ */
+uint8 Protocol_isValidLength(uint8 type, uint8 length);
+
+#endif /* PROTOCOL_H_ */
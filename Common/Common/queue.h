@@ -0,0 +1,98 @@
+/******************************************************************************
+ *
+ * Module: Queue
+ *
+ * File Name: queue.h
+ *
+ * Description: Header-only single-producer single-consumer ring queue for
+ *              handing data from an ISR to the main loop, or back.
+ *
+ * One side only writes head, the other only writes tail. Both are single
+ * bytes, which the AVR loads and stores in one instruction, so neither side
+ * ever masks interrupts. The indices run freely and wrap at 256; the
+ * capacity is a power of two no larger than 128, so head - tail is always
+ * the fill level and an index becomes a slot with one AND.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef QUEUE_H_
+#define QUEUE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define QUEUE_MAX_CAPACITY      128
+
+/*
+ * Keeps the compiler from moving the item copy across the index store. The
+ * AVR executes in order, so nothing else is needed.
+ */
+#define QUEUE_BARRIER()         __asm__ __volatile__ ("" ::: "memory")
+
+/*
+ * Define a queue type and its functions for items of type, holding up to
+ * capacity items:
+ *
+ *     QUEUE_DEFINE(Key, uint8, 8)
+ *     static Key_QueueType g_keys;             zero-initialised = empty
+ *
+ *     ISR:        Key_push(&g_keys, key);      FALSE if full, key dropped
+ *     main loop:  while (Key_pop(&g_keys, &key)) { ... }
+ *
+ * Each queue must have exactly one producer and one consumer. A function
+ * called from both the main loop and an ISR is two producers.
+ */
+#define QUEUE_DEFINE(name, type, capacity)                                      \
+                                                                                \
+typedef char name##_QueueCapacityCheck[                                         \
+        ((((capacity) & ((capacity) - 1)) == 0)                                 \
+         && ((capacity) > 0) && ((capacity) <= QUEUE_MAX_CAPACITY)) ? 1 : -1];  \
+                                                                                \
+typedef struct {                                                                \
+    volatile uint8 head;    /* Next slot to fill, producer only */              \
+    volatile uint8 tail;    /* Next slot to empty, consumer only */             \
+    type items[capacity];                                                       \
+} name##_QueueType;                                                             \
+                                                                                \
+/* Producer side. Returns FALSE, dropping the item, if the queue is full */     \
+static inline uint8 name##_push(name##_QueueType *queue, type item)             \
+{                                                                               \
+    uint8 head = queue->head;                                                   \
+                                                                                \
+    if ((uint8)(head - queue->tail) == (capacity))                              \
+    {                                                                           \
+        return FALSE;                                                           \
+    }                                                                           \
+    queue->items[head & ((capacity) - 1)] = item;                               \
+    QUEUE_BARRIER();                                                            \
+    queue->head = head + 1;     /* Publishes the item */                        \
+    return TRUE;                                                                \
+}                                                                               \
+                                                                                \
+/* Consumer side. Returns FALSE, leaving item untouched, if the queue is empty */\
+static inline uint8 name##_pop(name##_QueueType *queue, type *item)             \
+{                                                                               \
+    uint8 tail = queue->tail;                                                   \
+                                                                                \
+    if (tail == queue->head)                                                    \
+    {                                                                           \
+        return FALSE;                                                           \
+    }                                                                           \
+    *item = queue->items[tail & ((capacity) - 1)];                              \
+    QUEUE_BARRIER();                                                            \
+    queue->tail = tail + 1;     /* Frees the slot */                            \
+    return TRUE;                                                                \
+}                                                                               \
+                                                                                \
+/* Either side, a snapshot that may be stale by the time it is used */          \
+static inline uint8 name##_count(const name##_QueueType *queue)                 \
+{                                                                               \
+    return (uint8)(queue->head - queue->tail);                                  \
+}
+
+#endif /* QUEUE_H_ */
@@ -13,6 +13,8 @@
 #ifndef STD_TYPES_H_
 #define STD_TYPES_H_
 
+#include <stdint.h>
+
 /* Boolean Data Type */
 typedef unsigned char boolean;
 
@@ -29,14 +31,15 @@ typedef unsigned char boolean;
 
 #define NULL_PTR    ((void*)0)
 
-typedef unsigned char         uint8;          /*           0 .. 255              */
-typedef signed char           sint8;          /*        -128 .. +127             */
-typedef unsigned short        uint16;         /*           0 .. 65535            */
-typedef signed short          sint16;         /*      -32768 .. +32767           */
-typedef unsigned long         uint32;         /*           0 .. 4294967295       */
-typedef signed long           sint32;         /* -2147483648 .. +2147483647      */
-typedef unsigned long long    uint64;         /*       0 .. 18446744073709551615  */
-typedef signed long long      sint64;         /* -9223372036854775808 .. 9223372036854775807 */
+/* Exact width types, so the same sources also build for the host simulation */
+typedef uint8_t               uint8;          /*           0 .. 255              */
+typedef int8_t                sint8;          /*        -128 .. +127             */
+typedef uint16_t              uint16;         /*           0 .. 65535            */
+typedef int16_t               sint16;         /*      -32768 .. +32767           */
+typedef uint32_t              uint32;         /*           0 .. 4294967295       */
+typedef int32_t               sint32;         /* -2147483648 .. +2147483647      */
+typedef uint64_t              uint64;         /*       0 .. 18446744073709551615  */
+typedef int64_t               sint64;         /* -9223372036854775808 .. 9223372036854775807 */
 typedef float                 float32;
 typedef double                float64;
 
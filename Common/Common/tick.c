@@ -0,0 +1,70 @@
+/******************************************************************************
+ *
+ * Module: Tick
+ *
+ * File Name: tick.c
+ *
+ * Description: Source file for the millisecond system tick service
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "tick.h"
+#include "timer.h"
+#include <avr/io.h> /* To save and restore SREG */
+#include <avr/interrupt.h>
+
+#if (F_CPU / TICK_TIMER_DIVIDER) % TICKS_PER_SECOND != 0
+#warning "F_CPU is not a whole number of Timer2 counts per tick, the tick runs slightly fast"
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+volatile Tick_Type Tick_count = 0;
+
+const uint8 CPU_CLOCK_SYMBOL = 0;  /* Checked by the applications, see cpu_clock.h */
+
+TIMER_CLAIM(TIMER2);
+TIMER_CLAIM_CHANNEL(TIMER2, OC2);   /* CTC compare, no output pin */
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Tick_init(void)
+{
+    Timer_ConfigType timerConfig = {
+            .initial_value = 0,
+            .compare_value = TICK_TIMER_COMPARE,
+            .timer_id = TIMER2_ID,
+            .mode = TIMER_MODE_CTC,
+            .prescaler = TICK_TIMER_PRESCALER
+    };
+
+#if !TICK_STATIC_ISR
+    Timer_setCallBack_CTC(Tick_isr, TIMER2_ID);
+#endif
+    Timer_init(&timerConfig);
+}
+
+Tick_Type Tick_get(void)
+{
+    Tick_Type ticks;
+    uint8 sreg = SREG;
+
+    /* A 4-byte read is not atomic on the AVR, keep the ISR out while copying */
+    cli();
+    ticks = Tick_count;
+    SREG = sreg;
+
+    return ticks;
+}
+
+uint8 Tick_hasElapsed(Tick_Type start, Tick_Type duration)
+{
+    /* Unsigned subtraction stays correct across a wrap of the counter */
+    return ((Tick_get() - start) >= duration) ? TRUE : FALSE;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+ *
+ * Module: Tick
+ *
+ * File Name: tick.h
+ *
+ * Description: Header file for the millisecond system tick service
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef TICK_H_
+#define TICK_H_
+
+#include "std_types.h"
+#include "cpu_clock.h"
+#include "timer.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define TICKS_PER_SECOND         1000UL
+
+/*
+ * Timer2 in CTC mode, one compare match per tick. The prescaler is the
+ * smallest that fits a tick into the 8-bit counter: 125 counts of 64 cycles
+ * at 8MHz, 250 at 16MHz.
+ */
+#if (F_CPU / 8UL / TICKS_PER_SECOND) <= 256
+#define TICK_TIMER_PRESCALER     TIMER_PRESCALER_8
+#define TICK_TIMER_DIVIDER       8UL
+#elif (F_CPU / 64UL / TICKS_PER_SECOND) <= 256
+#define TICK_TIMER_PRESCALER     TIMER_PRESCALER_64
+#define TICK_TIMER_DIVIDER       64UL
+#elif (F_CPU / 256UL / TICKS_PER_SECOND) <= 256
+#define TICK_TIMER_PRESCALER     TIMER_PRESCALER_256
+#define TICK_TIMER_DIVIDER       256UL
+#else
+#error "F_CPU too fast for the Timer2 tick"
+#endif
+
+#define TICK_TIMER_COMPARE       (F_CPU / TICK_TIMER_DIVIDER / TICKS_PER_SECOND - 1)
+
+/*
+ * 1: the Timer2 compare ISR increments the counter inline (timer_handlers.h).
+ * 0: Tick_init registers Tick_isr as a run-time callback instead.
+ */
+#ifndef TICK_STATIC_ISR
+#define TICK_STATIC_ISR          1
+#endif
+
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Milliseconds since Tick_init, wraps after ~49 days so compare differences only */
+typedef uint32 Tick_Type;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Written by Tick_isr only, read it through Tick_get */
+extern volatile Tick_Type Tick_count;
+
+/*******************************************************************************
+ *                       Inline Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Timer2 compare handler. Inline so timer.c can compile it into the ISR.
+ */
+static inline void Tick_isr(void)
+{
+    Tick_count++;
+}
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start Timer2 as the 1ms system tick. Global interrupts must be enabled.
+ */
+void Tick_init(void);
+
+/*
+ * Description :
+ * Return the current tick count, read atomically.
+ */
+Tick_Type Tick_get(void);
+
+/*
+ * Description :
+ * Return TRUE once at least duration ticks have passed since start.
+ */
+uint8 Tick_hasElapsed(Tick_Type start, Tick_Type duration);
+
+#endif /* TICK_H_ */
@@ -1,4 +1,5 @@
 #include "timer.h"
+#include "timer_handlers.h"
 #include <avr/io.h>
 #include <avr/interrupt.h>
 
@@ -10,6 +11,16 @@ static void (*Timer1_Callback_OVF)(void) = NULL_PTR;
 static void (*Timer2_Callback_CTC)(void) = NULL_PTR;
 static void (*Timer2_Callback_OVF)(void) = NULL_PTR;
 
+/*---- Timer2 CS22:0 encoding differs (adds 32 and 128), map the common enum onto it ----*/
+static const uint8 Timer2_prescalerBits[] = {
+    0, /* TIMER_PRESCALER_OFF  */
+    1, /* TIMER_PRESCALER_1    */
+    2, /* TIMER_PRESCALER_8    */
+    4, /* TIMER_PRESCALER_64   */
+    6, /* TIMER_PRESCALER_256  */
+    7  /* TIMER_PRESCALER_1024 */
+};
+
 /*---- Internal function to set timer prescaler ----*/
 static void Timer_setPrescaler(Timer_ID_Type timer_id, Timer_PrescalerType prescaler) {
     switch (timer_id) {
@@ -26,7 +37,7 @@ static void Timer_setPrescaler(Timer_ID_Type timer_id, Timer_PrescalerType presc
         case TIMER2_ID:
             /*---- Clear and set Timer2 prescaler bits ----*/
             TCCR2 &= ~((1 << CS22) | (1 << CS21) | (1 << CS20));
-            TCCR2 |= prescaler;
+            TCCR2 |= Timer2_prescalerBits[prescaler];
             break;
     }
 }
@@ -132,31 +143,67 @@ void Timer_setCallBack_OVF(void (*callback)(void), Timer_ID_Type timer_id) {
  *******************************************************************************/
 
 /*---- Timer0 Compare Match Interrupt ----*/
+#ifdef TIMER0_CTC_HANDLER
+ISR(TIMER0_COMP_vect) {
+    TIMER0_CTC_HANDLER();
+}
+#else
 ISR(TIMER0_COMP_vect) {
     if (Timer0_Callback_CTC != NULL_PTR) Timer0_Callback_CTC();
 }
+#endif
 
 /*---- Timer0 Overflow Interrupt ----*/
+#ifdef TIMER0_OVF_HANDLER
+ISR(TIMER0_OVF_vect)  {
+    TIMER0_OVF_HANDLER();
+}
+#else
 ISR(TIMER0_OVF_vect)  {
     if (Timer0_Callback_OVF != NULL_PTR) Timer0_Callback_OVF();
 }
+#endif
 
 /*---- Timer1 Compare Match A Interrupt ----*/
+#ifdef TIMER1_CTC_HANDLER
+ISR(TIMER1_COMPA_vect) {
+    TIMER1_CTC_HANDLER();
+}
+#else
 ISR(TIMER1_COMPA_vect) {
     if (Timer1_Callback_CTC != NULL_PTR) Timer1_Callback_CTC();
 }
+#endif
 
 /*---- Timer1 Overflow Interrupt ----*/
+#ifdef TIMER1_OVF_HANDLER
+ISR(TIMER1_OVF_vect)   {
+    TIMER1_OVF_HANDLER();
+}
+#else
 ISR(TIMER1_OVF_vect)   {
     if (Timer1_Callback_OVF != NULL_PTR) Timer1_Callback_OVF();
 }
+#endif
 
 /*---- Timer2 Compare Match Interrupt ----*/
+#ifdef TIMER2_CTC_HANDLER
+ISR(TIMER2_COMP_vect) {
+    TIMER2_CTC_HANDLER();
+}
+#else
 ISR(TIMER2_COMP_vect) {
     if (Timer2_Callback_CTC != NULL_PTR) Timer2_Callback_CTC();
 }
+#endif
 
 /*---- Timer2 Overflow Interrupt ----*/
+#ifdef TIMER2_OVF_HANDLER
+ISR(TIMER2_OVF_vect)  {
+    TIMER2_OVF_HANDLER();
+}
+#else
 ISR(TIMER2_OVF_vect)  {
     if (Timer2_Callback_OVF != NULL_PTR) Timer2_Callback_OVF();
 }
+#endif
@@ -2,6 +2,7 @@
 #define TIMER_H_
 
 #include "std_types.h"
+#include <avr/pgmspace.h> /* Claims are flash symbols, no RAM */
 
 /*******************************************************************************
  *                                Timer IDs                                   *
@@ -32,6 +33,27 @@ typedef enum {
     TIMER_MODE_CTC
 } Timer_ModeType;
 
+/*******************************************************************************
+ *                              Timer Ownership                               *
+ *******************************************************************************/
+/*
+ * Every driver that programs a timer claims it once at file scope, also when
+ * it writes the registers itself instead of calling Timer_init:
+ *
+ *     TIMER_CLAIM(TIMER2);               counter, mode, prescaler
+ *     TIMER_CLAIM_CHANNEL(TIMER0, OC0);  compare unit and its output pin
+ *
+ * A claim defines a symbol, so a second claim of the same resource in one
+ * image fails the link with "multiple definition of Timer_claim_TIMER2" and
+ * names both files. A driver that only uses a compare channel of a counter
+ * someone else runs claims the channel alone.
+ *
+ * Software that needs periodic work shares the Timer2 tick through
+ * Tick_get / Tick_hasElapsed instead of claiming a timer of its own.
+ */
+#define TIMER_CLAIM(timer)                  const uint8 Timer_claim_##timer PROGMEM = 0
+#define TIMER_CLAIM_CHANNEL(timer, channel) const uint8 Timer_claim_##timer##_##channel PROGMEM = 0
+
 /*******************************************************************************
  *                          Configuration Structure                            *
  *******************************************************************************/
@@ -49,7 +71,7 @@ typedef struct {
 void Timer_init(const Timer_ConfigType *config);
 void Timer_deInit(Timer_ID_Type timer_id);
 
-/* Separate registration for each type of interrupt */
+/* Separate registration for each type of interrupt, ignored for vectors bound in timer_handlers.h */
 void Timer_setCallBack_CTC(void (*callback)(void), Timer_ID_Type timer_id);
 void Timer_setCallBack_OVF(void (*callback)(void), Timer_ID_Type timer_id);
 
@@ -0,0 +1,40 @@
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer_handlers.h
+ *
+ * Description: Compile-time bindings of timer vectors to inline handlers,
+ *              read by timer.c in place of the run-time callbacks
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef TIMER_HANDLERS_H_
+#define TIMER_HANDLERS_H_
+
+/*******************************************************************************
+ *                      Compile-Time Handler Bindings                          *
+ *******************************************************************************/
+/*
+ * A vector listed here calls its handler straight from the ISR in timer.c.
+ * The handler must be a static inline function in a header so its body is
+ * compiled into the ISR: no pointer load, no NULL test, no indirect call, and
+ * the prologue saves only the registers the body uses instead of every
+ * call-clobbered one.
+ *
+ * Vectors that are not listed keep the run-time callbacks of timer.h. A
+ * callback registered on a bound vector is never called.
+ *
+ *     #define TIMERn_CTC_HANDLER()   Module_isr()
+ *     #define TIMERn_OVF_HANDLER()   Module_isr()
+ */
+
+/*---- Timer2 compare: 1ms system tick ----*/
+#include "tick.h"
+#if TICK_STATIC_ISR
+#define TIMER2_CTC_HANDLER()    Tick_isr()
+#endif
+
+#endif /* TIMER_HANDLERS_H_ */
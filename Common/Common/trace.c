@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: trace.c
+ *
+ * Description: Source file for the binary event trace
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "trace.h"
+
+#if TRACE_ENABLE
+
+#include "tick.h"
+#include "link.h"
+#include "protocol.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static Trace_RecordType g_trace[TRACE_SIZE];
+static uint16 g_total = 0;          /* Records ever written, the head is its low bits */
+static volatile uint8 g_paused = FALSE; /* Set while dumping, so the dump does not trace itself */
+static volatile uint8 g_held = FALSE;   /* Set by a fault, keeps its history until the dump */
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Trace_record(uint8 event, uint8 arg0, uint8 arg1)
+{
+    Trace_RecordType *record;
+    uint16 time = (uint16)Tick_get();
+    uint8 sreg = SREG;
+
+    cli();
+    if (!g_paused && !g_held)
+    {
+        record = &g_trace[g_total & (TRACE_SIZE - 1)];
+        record->time = time;
+        record->event = event;
+        record->arg0 = arg0;
+        record->arg1 = arg1;
+        g_total++;
+    }
+    SREG = sreg;
+}
+
+void Trace_dump(uint8 seq)
+{
+    uint8 count = (g_total < TRACE_SIZE) ? (uint8)g_total : TRACE_SIZE;
+    uint16 index = g_total - count;
+    Protocol_TraceHeaderType header = { count, (uint8)g_total, (uint8)(g_total >> 8) };
+    RESPONSE_TRACE_PayloadType frame;
+    uint8 length;
+    const Trace_RecordType *record;
+
+    g_paused = TRUE;
+    Link_sendFrame(RESPONSE_TRACE, seq, (const uint8 *)&header, sizeof(header));
+
+    while (count != 0)
+    {
+        for (length = 0; count != 0 && length < sizeof(frame.records); count--)
+        {
+            record = &g_trace[index++ & (TRACE_SIZE - 1)];
+            frame.records[length++] = (uint8)record->time;
+            frame.records[length++] = (uint8)(record->time >> 8);
+            frame.records[length++] = record->event;
+            frame.records[length++] = record->arg0;
+            frame.records[length++] = record->arg1;
+        }
+        Link_sendFrame(RESPONSE_TRACE, seq, frame.records, length);
+    }
+    g_held = FALSE;
+    g_paused = FALSE;
+}
+
+void Trace_fault(uint8 code)
+{
+    Trace_record(TRACE_FAULT, code, 0);
+    g_held = TRUE;
+}
+
+#endif /* TRACE_ENABLE */
@@ -0,0 +1,112 @@
+/******************************************************************************
+ *
+ * Module: Trace
+ *
+ * File Name: trace.h
+ *
+ * Description: Header file for the binary event trace, a RAM ring of small
+ *              timestamped records dumped in RESPONSE_TRACE frames for
+ *              Host/trace_decode
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef TRACE_H_
+#define TRACE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* 1: record events. Shared by libCommon.a and both applications */
+#ifndef TRACE_ENABLE
+#define TRACE_ENABLE            0
+#endif
+
+/* 1: also record every link byte. Fills the ring within one exchange */
+#ifndef TRACE_UART_BYTES
+#define TRACE_UART_BYTES        0
+#endif
+
+/* Records kept, a power of 2 so the ring index is a mask */
+#define TRACE_SIZE              32
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+/* Host/trace_decode.c names these, keep the two in step */
+typedef enum {
+    TRACE_BOOT = 1,
+    TRACE_UART_TX,          /* arg0 = byte, TRACE_UART_BYTES builds only */
+    TRACE_UART_RX,          /* arg0 = byte, TRACE_UART_BYTES builds only */
+    TRACE_COMMAND,          /* arg0 = command being handled, arg1 = its sequence number (Control) */
+    TRACE_STATE,            /* arg0 = new state (HMI) */
+    TRACE_UNEXPECTED,       /* arg0 = expected byte, arg1 = received byte */
+    TRACE_EEPROM_ERROR,     /* arg0 = storage key (storage.h) */
+    TRACE_LOCKOUT,          /* arg0 = seconds */
+    TRACE_FAULT,            /* arg0 = fault code, the ring stops here until it is dumped */
+    TRACE_LINK_RATE,        /* arg0 = index into LINK_BAUD_RATES that was agreed */
+    TRACE_RETRY,            /* arg0 = sequence number resent, arg1 = attempt (HMI) */
+    TRACE_RESYNC,           /* arg0 = sequence number left unanswered (HMI) */
+    TRACE_DOOR_EDGE,        /* arg0 = 1 closed, 0 open, arg1 = low byte of the edge's tick (Control) */
+    TRACE_NUM_EVENTS
+} Trace_EventType;
+
+/* arg0 of TRACE_FAULT */
+typedef enum {
+    TRACE_FAULT_EEPROM_READ = 1,
+    TRACE_FAULT_EEPROM_WRITE,
+    TRACE_FAULT_POOL_FREE       /* Pool_free given a block it did not hand out */
+} Trace_FaultType;
+
+typedef struct {
+    uint16 time;            /* Low 16 bits of the ms tick */
+    uint8 event;
+    uint8 arg0;
+    uint8 arg1;
+} Trace_RecordType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+#if TRACE_ENABLE
+
+/*
+ * Description :
+ * Append a record, overwriting the oldest. Safe from ISRs and app code.
+ */
+void Trace_record(uint8 event, uint8 arg0, uint8 arg1);
+
+/*
+ * Description :
+ * Send the ring as RESPONSE_TRACE frames with sequence number seq: a
+ * Protocol_TraceHeaderType, then the records oldest first, up to
+ * PROTOCOL_TRACE_RECORDS a frame, PROTOCOL_TRACE_RECORD_SIZE bytes each:
+ * time (LSB first), event, arg0, arg1. A peer ECU ignores these frames, so
+ * the dump can go out on the live link. Resumes a ring stopped by a fault.
+ */
+void Trace_dump(uint8 seq);
+
+/*
+ * Description :
+ * Record TRACE_FAULT and stop recording, so the events that led to the
+ * fault are kept until the next dump.
+ */
+void Trace_fault(uint8 code);
+
+#define TRACE(event, arg0, arg1)    Trace_record((event), (arg0), (arg1))
+#define TRACE_FAULT_HOLD(code)      Trace_fault(code)
+
+#else
+
+#define TRACE(event, arg0, arg1)    ((void)0)
+#define TRACE_FAULT_HOLD(code)      ((void)0)
+
+#endif /* TRACE_ENABLE */
+
+#endif /* TRACE_H_ */
@@ -13,6 +13,14 @@
 #include "uart.h"
 #include "avr/io.h" /* To use the UART Registers */
 #include "common_macros.h" /* To use the macros like SET_BIT */
+#include "trace.h" /* To trace the link bytes */
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile uint8 g_txStarted = FALSE; /* TXC is only meaningful once a byte was sent */
+static uint8 g_framingError = FALSE;
 
 /*******************************************************************************
  *                      Functions Definitions                                  *
@@ -25,9 +33,7 @@
  * 2. Enable the UART.
  * 3. Setup the UART baud rate.
  */
-void UART_init(const UART_ConfigType *Config_Ptr) {
-    uint16 ubrr_value = (uint16)(((F_CPU / (8UL * Config_Ptr->baud_rate))) - 1);
-
+uint8 UART_init(const UART_ConfigType *Config_Ptr) {
     /* Double speed mode */
     UCSRA = (1 << U2X);
 
@@ -45,8 +51,46 @@ void UART_init(const UART_ConfigType *Config_Ptr) {
            (Config_Ptr->stop_bit << USBS);
 
     /* Set baud rate */
-    UBRRH = (ubrr_value >> 8);
-    UBRRL = ubrr_value;
+    return UART_setBaudRate(Config_Ptr->baud_rate);
+}
+
+/*
+ * Description :
+ * Switch the baud rate after the byte being sent has left the shift register.
+ * Returns FALSE, leaving the rate unchanged, when it cannot be reached within
+ * UART_MAX_BAUD_ERROR_PERMILLE at F_CPU.
+ */
+uint8 UART_setBaudRate(uint32 baud_rate)
+{
+	uint32 divisor, actual, error;
+
+	if (baud_rate == 0)
+	{
+		return FALSE;
+	}
+
+	divisor = UART_DIVISOR(baud_rate);
+	if ((divisor == 0) || (divisor > UART_MAX_DIVISOR))
+	{
+		return FALSE;
+	}
+
+	actual = F_CPU / (8UL * divisor);
+	error = (actual > baud_rate) ? (actual - baud_rate) : (baud_rate - actual);
+	if ((error * 1000UL) > (baud_rate * UART_MAX_BAUD_ERROR_PERMILLE))
+	{
+		return FALSE;
+	}
+
+	/* Changing UBRR mid-frame would corrupt the byte still being shifted out */
+	if (g_txStarted)
+	{
+		while(BIT_IS_CLEAR(UCSRA,TXC)){}
+	}
+
+	UBRRH = (uint8)((divisor - 1) >> 8);
+	UBRRL = (uint8)(divisor - 1);
+	return TRUE;
 }
 
 /*
@@ -61,11 +105,18 @@ void UART_sendByte(const uint8 data)
 	 */
 	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
 
+	/* Clear TXC (write one, keep U2X) so UART_setBaudRate can wait for this byte */
+	UCSRA = (1 << U2X) | (1 << TXC);
+	g_txStarted = TRUE;
+
 	/*
 	 * Put the required data in the UDR register and it also clear the UDRE flag as
 	 * the UDR register is not empty now
 	 */
 	UDR = data;
+#if TRACE_UART_BYTES
+	TRACE(TRACE_UART_TX, data, 0);
+#endif
 }
 
 /*
@@ -81,7 +132,30 @@ uint8 UART_recieveByte(void)
 	 * Read the received data from the Rx buffer (UDR)
 	 * The RXC flag will be cleared after read the data
 	 */
-    return UDR;
+	g_framingError = BIT_IS_SET(UCSRA,FE) ? TRUE : FALSE; /* Valid until UDR is read */
+	uint8 data = UDR;
+#if TRACE_UART_BYTES
+	TRACE(TRACE_UART_RX, data, 0);
+#endif
+	return data;
+}
+
+/*
+ * Description :
+ * Return TRUE if the last byte returned by UART_recieveByte had no valid stop bit.
+ */
+uint8 UART_hadFramingError(void)
+{
+	return g_framingError;
+}
+
+/*
+ * Description :
+ * Return TRUE if a received byte is waiting in the Rx buffer, without blocking.
+ */
+uint8 UART_isByteAvailable(void)
+{
+	return BIT_IS_SET(UCSRA,RXC) ? TRUE : FALSE;
 }
 
 /*
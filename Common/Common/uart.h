@@ -14,6 +14,22 @@
 #define UART_H_
 
 #include "std_types.h"
+#include "cpu_clock.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Largest accepted difference between the requested and the real baud rate, in 0.1% */
+#define UART_MAX_BAUD_ERROR_PERMILLE   20
+
+/* With U2X: baud = F_CPU / (8 * divisor), divisor = UBRR + 1 rounded to the nearest rate */
+#define UART_DIVISOR(baud)             (((F_CPU / 8UL) + ((baud) / 2)) / (baud))
+#define UART_ACTUAL_RATE(baud)         (F_CPU / (8UL * UART_DIVISOR(baud)))
+#define UART_ERROR_PERMILLE(baud)      (((UART_ACTUAL_RATE(baud) > (baud)) ? (UART_ACTUAL_RATE(baud) - (baud)) \
+                                        : ((baud) - UART_ACTUAL_RATE(baud))) * 1000UL / (baud))
+#define UART_MAX_DIVISOR               4096    /* UBRR is 12 bits */
+
 /*******************************************************************************
  *                         Types Declaration                                   *
  *******************************************************************************/
@@ -54,8 +70,25 @@ typedef struct {
  * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
  * 2. Enable the UART.
  * 3. Setup the UART baud rate.
+ * Returns FALSE, with the baud rate left unset, when the rate cannot be
+ * reached within UART_MAX_BAUD_ERROR_PERMILLE at F_CPU.
+ */
+uint8 UART_init(const UART_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Switch the baud rate after the byte being sent has left the shift register.
+ * Returns FALSE, leaving the rate unchanged, when it cannot be reached within
+ * UART_MAX_BAUD_ERROR_PERMILLE at F_CPU.
+ */
+uint8 UART_setBaudRate(uint32 baud_rate);
+
+/*
+ * Description :
+ * Return TRUE if the last byte returned by UART_recieveByte had no valid stop
+ * bit, the usual sign that the other side runs at a different baud rate.
  */
-void UART_init(const UART_ConfigType *Config_Ptr);
+uint8 UART_hadFramingError(void);
 
 /*
  * Description :
@@ -69,6 +102,12 @@ void UART_sendByte(const uint8 data);
  */
 uint8 UART_recieveByte(void);
 
+/*
+ * Description :
+ * Return TRUE if a received byte is waiting in the Rx buffer, without blocking.
+ */
+uint8 UART_isByteAvailable(void);
+
 /*
  * Description :
  * Send the required string through UART to the other UART device.
@@ -81,4 +120,4 @@ void UART_sendString(const uint8 *Str);
  */
 void UART_receiveString(uint8 *Str); // Receive until #
 
-#endif /* UART_H_ */
+#endif /* UART_H_ */
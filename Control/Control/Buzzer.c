@@ -14,6 +14,12 @@
 #include "gpio.h"
 #include "common_macros.h"
 
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_owners = 0;  /* Buzzer_OwnerType bits of the alarms sounding */
+
 /*******************************************************************************
  *                      Functions Definitions                                  *
  *******************************************************************************/
@@ -26,24 +32,22 @@ void Buzzer_init(void)
 {
     GPIO_setupPinDirection(BUZZER_PORT_ID, BUZZER_PIN_ID, PIN_OUTPUT);
     GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
+    g_owners = 0;
 }
 
 /*
  * Description:
- * Turns ON the Buzzer by setting the corresponding pin HIGH.
+ * Records the owner's request and drives the pin HIGH while any owner is left.
  */
-void Buzzer_on(void)
+void Buzzer_request(Buzzer_OwnerType owner, uint8 on)
 {
-    GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_HIGH);
+    if (on)
+    {
+        g_owners |= owner;
+    }
+    else
+    {
+        g_owners &= (uint8)~owner;
+    }
+    GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, (g_owners != 0) ? LOGIC_HIGH : LOGIC_LOW);
 }
-
-/*
- * Description:
- * Turns OFF the Buzzer by setting the corresponding pin LOW.
- */
-void Buzzer_off(void)
-{
-    GPIO_writePin(BUZZER_PORT_ID, BUZZER_PIN_ID, LOGIC_LOW);
-}
-
-
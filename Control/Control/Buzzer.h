@@ -13,14 +13,18 @@
 #ifndef BUZZER_H_
 #define BUZZER_H_
 
-#include "gpio.h"
+#include "board_config.h" /* Buzzer pin */
+#include "std_types.h"
 
 /*******************************************************************************
- *                                Definitions                                  *
+ *                         Types Declaration                                   *
  *******************************************************************************/
 
-#define BUZZER_PORT_ID   PORTC_ID
-#define BUZZER_PIN_ID    PIN7_ID
+/* Alarms that share the buzzer, one bit each */
+typedef enum {
+    BUZZER_OWNER_LOCKOUT = 0x01,
+    BUZZER_OWNER_DOOR    = 0x02
+} Buzzer_OwnerType;
 
 /*******************************************************************************
  *                              Function Prototypes                            *
@@ -34,15 +38,11 @@ void Buzzer_init(void);
 
 /*
  * Description:
- * Activates the Buzzer by setting the pin to HIGH.
+ * Turn owner's request for the buzzer on or off. The buzzer sounds while any
+ * owner has it on, so one alarm ending does not silence another. Main loop
+ * only.
  */
-void Buzzer_on(void);
-
-/*
- * Description:
- * Deactivates the Buzzer by setting the pin to LOW.
- */
-void Buzzer_off(void);
+void Buzzer_request(Buzzer_OwnerType owner, uint8 on);
 
 #endif /* BUZZER_H_ */
 
@@ -4,227 +4,622 @@
  */
 #include "std_types.h"
 #include "uart.h"
-#include "external_eeprom.h"
+#include "storage.h"
+#include "config_store.h"
 #include "Motor.h"
-#include "buzzer.h"
+#include "Buzzer.h"
 #include "twi.h"
 #include "PIR.h"
+#include "DoorContact.h"
 #include "timer.h"
 #include "interrupt.h"
-#include <util/delay.h>
-
-/*---- System Configuration Constants ----*/
-#define PASSWORD_LENGTH      5
-#define EEPROM_BASE_ADDRESS  0x0311
-#define MAX_ATTEMPTS         3
-#define LOCKING_TIME         1
-#define LOCKOUT_TIME         3
-#define EEPROM_INIT_FLAG     0x55
-#define EEPROM_FLAG_ADDR     (EEPROM_BASE_ADDRESS + PASSWORD_LENGTH)
-
-/*---- UART Command Definitions ----*/
+#include "blake2s.h"
+#include "secure_compare.h"
+#include "tick.h"
+#include "cpu_clock.h"
+#include "lockout.h"
+#include "audit_log.h"
+#include "profile.h"
+#include "trace.h"
+#include "link.h"
+#include "protocol.h"
+#include "idle.h"
+#include "pool.h"
+
+/*---- System Configuration Constants (site settings are in config.h) ----*/
+#define SALT_LENGTH          8
+#define HASH_LENGTH          16   /*---- Truncated BLAKE2s-128 digest ----*/
+
+/*---- Build Options ----*/
+#define HASH_BENCHMARK       0    /*---- 1: answer CMD_HASH_BENCHMARK with cycles to verify a candidate ----*/
+
+/*---- Door Sequence States ----*/
 typedef enum {
-	CMD_CREATE_PASSWORD = 0x01,
-	CMD_OPEN_DOOR       = 0x03,
-	CMD_CHANGE_PASSWORD = 0x04,
-	CMD_LOCK_SYSTEM     = 0x06,
-	CMD_CHECK_INIT      = 0x07
-} UART_Command;
-
-/*---- UART Response Definitions ----*/
-typedef enum {
-	RESPONSE_OK           = 0xAA,
-	RESPONSE_ERROR        = 0xFF,
-	RESPONSE_PIR_DETECTED = 0x55,
-	RESPONSE_PIR_NOT_DETECTED = 0x66,
-	NEXT_DIGIT = 0xE3,
-} UART_Response;
+	DOOR_IDLE,
+	DOOR_UNLOCKING,
+	DOOR_HOLD,       /*---- Unlocked and shut while the PIR sees people ----*/
+	DOOR_OPEN,       /*---- Contact open, relocks once it is shut and settled ----*/
+	DOOR_LOCKING,
+} DoorState;
+
+/*---- Stored Credential: salt followed by BLAKE2s(salt || password), STORAGE_CREDENTIAL_SIZE bytes ----*/
+typedef struct {
+	uint8 salt[SALT_LENGTH];
+	uint8 hash[HASH_LENGTH];
+	uint8 length;  /*---- Digits, a new configured length applies to the next password only ----*/
+} Credential;
+
+/*---- Storage_read copies the record straight into the struct ----*/
+_Static_assert(sizeof(Credential) == STORAGE_CREDENTIAL_SIZE, "Credential does not match STORAGE_CREDENTIAL_SIZE");
 
 /*---- Peripheral Configuration Structures ----*/
 TWI_ConfigType twi_config = {
 		.address = 0x01,     /*---- Optional I2C slave address ----*/
-		.bit_rate = 0x02     /*---- 400kHz SCL for 8MHz CPU ----*/
+		.bit_rate = TWI_DEFAULT_BIT_RATE /*---- Fastest SCL at F_CPU, the configured rate is set once the store is loaded ----*/
 };
 
 UART_ConfigType uart_config = {
 		.bit_data = UART_8_BIT_DATA,
 		.parity = UART_PARITY_DISABLED,
 		.stop_bit = UART_1_STOP_BIT,
-		.baud_rate = 9600
+		.baud_rate = LINK_BASE_BAUD_RATE /*---- Raised by the negotiation after CMD_CHECK_INIT ----*/
 };
 
-/*---- Timer Control Variables ----*/
-static volatile uint8 timer_elapsed = 0;  /*---- Global timer counter ----*/
+/*---- Global Variables ----*/
+Link_FrameType request; /*---- Current UART command ----*/
+
+/*---- Last Reply, Sent Again when the HMI Retransmits its Request ----*/
+static Link_FrameType lastReply;
+static uint8 lastRequestType = 0; /*---- 0: nothing cached ----*/
+static uint8 linkUp = FALSE;      /*---- CMD_CHECK_INIT seen since reset ----*/
+static uint8 changeVerified = FALSE; /*---- Old password just verified, good for the next frame only ----*/
+
+/*---- Reply to a Request and Remember the Reply ----*/
+void sendReply(uint8 requestType, uint8 response, uint8 seq, const uint8* payload, uint8 length) {
+	lastRequestType = requestType;
+	lastReply.type = response;
+	lastReply.seq = seq;
+	lastReply.length = length;
+	for (uint8 i = 0; i < length; i++) {
+		lastReply.payload[i] = payload[i];
+	}
+	Link_sendFrame(response, seq, payload, length);
+}
 
-/*---- Timer Callback Function ----*/
-void Timer_CTC_Callback(void) {
-	timer_elapsed++;
+/*---- Reply without Payload to the Current Request ----*/
+void sendResponse(uint8 response, uint8 seq) {
+	sendReply(request.type, response, seq, NULL_PTR, 0);
 }
 
-/*---- Non-blocking Delay Function ----*/
-void Control_delaySeconds(uint8 seconds) {
-	Timer_ConfigType timerConfig = {
-			.initial_value = 0,
-			.compare_value = 31249,    /*---- 1 second at 8MHz/256 prescaler ----*/
-			.timer_id = TIMER1_ID,
-			.mode = TIMER_MODE_CTC,
-			.prescaler = TIMER_PRESCALER_256
-	};
+/*---- Report a Running Lockout to the HMI ----*/
+void sendLockedResponse(uint8 seq) {
+	RESPONSE_LOCKED_PayloadType locked = { Lockout_remainingSeconds() };
 
-	timer_elapsed = 0;
-	Timer_init(&timerConfig);
-	Timer_setCallBack_CTC(Timer_CTC_Callback, TIMER1_ID);
+	sendReply(request.type, RESPONSE_LOCKED, seq, (const uint8*)&locked, sizeof(locked));
+}
+
+/*---- Count a Wrong Password and Reply ----*/
+void handleWrongPassword(uint8 seq) {
+	AuditLog_record(AUDIT_EVENT_AUTH_FAILURE, AUDIT_USER_DEFAULT, AUDIT_RESULT_WRONG_PASSWORD);
+
+	if (Lockout_recordFailure()) {
+		AuditLog_record(AUDIT_EVENT_LOCKOUT, AUDIT_USER_DEFAULT, Lockout_remainingSeconds());
+		TRACE(TRACE_LOCKOUT, Lockout_remainingSeconds(), 0);
+		sendLockedResponse(seq); /*---- This failure reached the limit ----*/
+	} else {
+		sendResponse(RESPONSE_ERROR, seq);
+	}
+}
 
-	while (timer_elapsed < seconds);  /*---- Wait for specified time ----*/
-	Timer_deInit(TIMER1_ID);
+/*---- Digits of the Password Stored in EEPROM, 0 if None ----*/
+uint8 storedPasswordLength(void) {
+	Credential credential;
+
+	/*---- A valid record CRC is the init flag ----*/
+	return (Storage_read(STORAGE_KEY_CREDENTIAL, &credential) == SUCCESS) ? credential.length : 0;
+}
+
+/*---- Apply Configured Peripheral Settings, the Rest is Read where it is Used ----*/
+void applyConfig(void) {
+	twi_config.bit_rate = Config_get()->twiBitRate;
+	TWI_init(&twi_config);
+}
+
+/*---- Request timing entropy for salt generation, counts idle loops ----*/
+static uint16 salt_entropy = 0;
+
+/*---- Hash a Password with its Salt ----*/
+void hashPassword(const uint8* salt, const uint8* password, uint8 length, uint8* hash) {
+	BLAKE2s_ContextType ctx;
+
+	BLAKE2s_init(&ctx, HASH_LENGTH);
+	BLAKE2s_update(&ctx, salt, SALT_LENGTH);
+	BLAKE2s_update(&ctx, password, length);
+	BLAKE2s_final(&ctx, hash);
 }
 
-/*---- Check if Password is Stored in EEPROM ----*/
-uint8 IsPasswordStored() {
-	uint8 flag;
-	EEPROM_readByte(EEPROM_FLAG_ADDR, &flag);
-	_delay_ms(10); /*---- EEPROM read delay ----*/
-	return (flag == EEPROM_INIT_FLAG);
+/*---- Derive a Fresh Salt ----*/
+void generateSalt(uint8* salt) {
+	BLAKE2s_ContextType ctx;
+	Credential old;
+
+	/*---- A salt must be unique, not secret: chain the old salt with keystroke timing ----*/
+	BLAKE2s_init(&ctx, SALT_LENGTH);
+	Storage_read(STORAGE_KEY_CREDENTIAL, &old); /*---- Erased bytes serve as well on the first run ----*/
+	BLAKE2s_update(&ctx, old.salt, SALT_LENGTH);
+	BLAKE2s_update(&ctx, (const uint8*)&salt_entropy, sizeof(salt_entropy));
+	BLAKE2s_final(&ctx, salt);
 }
 
-/*---- Receive Password with Handshaking ----*/
-void receivePassword(uint8* buffer) {
-	for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
-		buffer[i] = UART_recieveByte();
-		UART_sendByte(NEXT_DIGIT); /*---- Acknowledge each digit ----*/
+/*---- Save Password to EEPROM as a Salted Hash ----*/
+void savePasswordToEEPROM(const uint8* password, uint8 length) {
+	Credential credential;
+
+	generateSalt(credential.salt);
+	hashPassword(credential.salt, password, length, credential.hash);
+	credential.length = length;
+
+	/*---- Goes to both tiers, the record CRC marks it as initialized ----*/
+	if (Storage_write(STORAGE_KEY_CREDENTIAL, &credential) == ERROR) {
+		TRACE(TRACE_EEPROM_ERROR, STORAGE_KEY_CREDENTIAL, 0);
+		TRACE_FAULT_HOLD(TRACE_FAULT_EEPROM_WRITE);
 	}
 }
 
-/*---- Compare Two Passwords ----*/
-uint8 comparePasswords(uint8* p1, uint8* p2) {
-	for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
-		if (p1[i] != p2[i]) return 0;
+/*---- Read Stored Credential from EEPROM ----*/
+void readPasswordFromEEPROM(Credential* credential) {
+	PROFILE_BEGIN(PROFILE_EEPROM_READ_PASSWORD);
+	if (Storage_read(STORAGE_KEY_CREDENTIAL, credential) == ERROR) { /*---- Internal tier, no I2C traffic ----*/
+		TRACE(TRACE_EEPROM_ERROR, STORAGE_KEY_CREDENTIAL, 0);
+		TRACE_FAULT_HOLD(TRACE_FAULT_EEPROM_READ);
+	}
+	PROFILE_END(PROFILE_EEPROM_READ_PASSWORD);
+}
+
+/*---- Check a Password against the Stored Credential ----*/
+uint8 verifyPassword(const uint8* password, const Credential* credential) {
+	uint8 hash[HASH_LENGTH], match;
+
+	PROFILE_BEGIN(PROFILE_VERIFY_PASSWORD);
+	hashPassword(credential->salt, password, credential->length, hash);
+	match = SecureCompare_equal(hash, credential->hash, HASH_LENGTH);
+	PROFILE_END(PROFILE_VERIFY_PASSWORD);
+	return match;
+}
+
+/*---- Speculative Verification of the Password being Typed ----*/
+typedef enum {
+	SPEC_IDLE,
+	SPEC_RUNNING,
+	SPEC_MATCH,
+	SPEC_MISMATCH,
+} SpecState;
+
+static SpecState specState = SPEC_IDLE;
+static uint8 specCount;                      /*---- Digits received in order ----*/
+static uint8 specDigits[PASSWORD_MAX_LENGTH];
+static Credential specCredential;            /*---- Prefetched at the first digit ----*/
+
+/*---- Take a Streamed Digit, Verify as soon as the Last one Arrives ----*/
+void speculateDigit(uint8 index, uint8 digit) {
+	if (index == 0) {
+		readPasswordFromEEPROM(&specCredential); /*---- While the user types the rest ----*/
+		specCount = 0;
+		specState = SPEC_RUNNING;
+	}
+	if (specState != SPEC_RUNNING || index != specCount || index >= specCredential.length || index >= PASSWORD_MAX_LENGTH) {
+		specState = SPEC_IDLE; /*---- A digit went missing, the request is verified in full ----*/
+		return;
+	}
+
+	specDigits[specCount++] = digit;
+	if (specCount == specCredential.length) {
+		specState = verifyPassword(specDigits, &specCredential) ? SPEC_MATCH : SPEC_MISMATCH;
 	}
-	return 1;
 }
 
-/*---- Save Password to EEPROM ----*/
-void savePasswordToEEPROM(uint8* password) {
-	for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
-		EEPROM_writeByte(EEPROM_BASE_ADDRESS + i, password[i]);
-		_delay_ms(10); /*---- EEPROM write delay ----*/
+/*---- Verify a Candidate, Reusing the Speculative Verdict when it is for the Same Digits ----*/
+uint8 checkCandidate(const uint8* password) {
+	Credential credential;
+	uint8 match;
+
+	if ((specState == SPEC_MATCH || specState == SPEC_MISMATCH)
+			&& SecureCompare_equal(password, specDigits, specCount)) { /*---- The request length is checked already ----*/
+		match = (specState == SPEC_MATCH);
+	} else {
+		readPasswordFromEEPROM(&credential);
+		match = verifyPassword(password, &credential);
 	}
-	EEPROM_writeByte(EEPROM_FLAG_ADDR, EEPROM_INIT_FLAG); /*---- Set initialization flag ----*/
-	_delay_ms(10);
+	specState = SPEC_IDLE; /*---- One verdict per typed password ----*/
+	return match;
+}
+
+#if HASH_BENCHMARK
+TIMER_CLAIM(TIMER1); /*---- Shared with nothing: a profiling build fails to link ----*/
+
+/*---- Timer1 overflows during a benchmark run ----*/
+static volatile uint16 benchmark_overflows = 0;
+
+void Timer_Benchmark_Callback(void) {
+	benchmark_overflows++;
 }
 
-/*---- Read Password from EEPROM ----*/
-void readPasswordFromEEPROM(uint8* password) {
-	for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
-		EEPROM_readByte(EEPROM_BASE_ADDRESS + i, &password[i]);
-		_delay_ms(10); /*---- EEPROM read delay ----*/
+/*---- Measure CPU Cycles of one Verification (EEPROM read + hash + compare) ----*/
+uint32 benchmarkVerification(const uint8* candidate) {
+	Timer_ConfigType timerConfig = {
+			.initial_value = 0,
+			.compare_value = 0,
+			.timer_id = TIMER1_ID,
+			.mode = TIMER_MODE_NORMAL,
+			.prescaler = TIMER_PRESCALER_1 /*---- One count per CPU cycle ----*/
+	};
+	Credential credential;
+	uint32 cycles;
+
+	benchmark_overflows = 0;
+	Timer_setCallBack_OVF(Timer_Benchmark_Callback, TIMER1_ID);
+	Timer_init(&timerConfig);
+
+	readPasswordFromEEPROM(&credential);
+	verifyPassword(candidate, &credential);
+
+	Timer_deInit(TIMER1_ID); /*---- Stops the clock, TCNT1 holds the count ----*/
+	cycles = ((uint32)benchmark_overflows << 16) | TCNT1;
+	if (TIFR & (1 << TOV1)) {
+		/*---- Overflow raced with the stop and was never serviced ----*/
+		cycles += 0x10000UL;
+		TIFR = (1 << TOV1);
 	}
+	return cycles;
+}
+#endif
+
+/*---- Door Sequence State ----*/
+static DoorState doorState = DOOR_IDLE;
+static uint8 doorSeq;       /*---- Request the events belong to ----*/
+static Tick_Type doorStart; /*---- Start of the current motor run, or when the door opened ----*/
+static uint8 doorAlarm;     /*---- Held-open alarm sounding ----*/
+
+/*---- Stream a Door Event to the HMI ----*/
+void sendDoorEvent(uint8 event) {
+	Link_sendFrame(event, doorSeq, NULL_PTR, 0);
 }
 
-/*---- Door Control Sequence ----*/
-void Door_Control_Sequence(void) {
-	/*---- Phase 1: Unlocking ----*/
+/*---- Begin the Door Sequence, Door_service does the rest ----*/
+void Door_start(uint8 seq) {
+	PROFILE_BEGIN(PROFILE_DOOR_SEQUENCE);
+	doorSeq = seq;
+	doorState = DOOR_UNLOCKING;
+	doorStart = Tick_get();
+	doorAlarm = FALSE;
 	Motor_rotate(MOTOR_CW, 100); /*---- Rotate motor clockwise ----*/
-	Control_delaySeconds(LOCKING_TIME);
-	Motor_rotate(MOTOR_STOP, 0);
+	sendDoorEvent(EVENT_UNLOCKING);
+}
 
-	/*---- Check for motion detection ----*/
-	if(PIR_getState() == LOGIC_HIGH) {
-		UART_sendByte(RESPONSE_PIR_DETECTED);
-		while (PIR_getState() == LOGIC_HIGH){} /*---- Wait while motion detected ----*/
-	}
-	UART_sendByte(RESPONSE_PIR_NOT_DETECTED);
+/*---- The Door was Pushed Open: Time how Long it Stays Open ----*/
+void Door_opened(void) {
+	doorStart = Tick_get();
+	doorState = DOOR_OPEN;
+	sendDoorEvent(EVENT_DOOR_OPEN);
+}
 
-	/*---- Phase 2: Locking ----*/
+/*---- Phase 2: Locking ----*/
+void Door_lock(void) {
 	Motor_rotate(MOTOR_ACW, 100); /*---- Rotate motor counter-clockwise ----*/
-	Control_delaySeconds(LOCKING_TIME);
+	doorStart = Tick_get();
+	doorState = DOOR_LOCKING;
+	sendDoorEvent(EVENT_LOCKING);
+}
 
-	/*---- Final Phase: Stop Motor ----*/
-	Motor_rotate(MOTOR_STOP, 0);
+/*---- Advance the Door Sequence without Blocking the Command Loop ----*/
+void Door_service(void) {
+	switch (doorState) {
+	case DOOR_IDLE:
+		break;
+
+		/*---- Phase 1: Unlocking ----*/
+	case DOOR_UNLOCKING:
+		if (!Tick_hasElapsed(doorStart, Config_get()->lockingTime * TICKS_PER_SECOND)) {
+			break;
+		}
+		Motor_rotate(MOTOR_STOP, 0);
+
+		/*---- Check for motion detection ----*/
+		if (!DoorContact_isClosed()) {
+			Door_opened(); /*---- Pushed open as soon as the bolt was back ----*/
+			break;
+		}
+		if (PIR_getState() == LOGIC_HIGH) {
+			sendDoorEvent(EVENT_PIR_HOLD);
+			AuditLog_record(AUDIT_EVENT_PIR_HOLD, AUDIT_USER_DEFAULT, AUDIT_RESULT_OK);
+			doorState = DOOR_HOLD;
+			break;
+		}
+		/*---- No break: lock right away ----*/
+
+		/*---- Wait while motion detected, unless the door opens ----*/
+	case DOOR_HOLD:
+		if (!DoorContact_isClosed()) {
+			Door_opened();
+		} else if (PIR_getState() == LOGIC_LOW) {
+			Door_lock();
+		}
+		break;
+
+		/*---- Relock the Moment the Door is Shut, the PIR no longer Matters ----*/
+	case DOOR_OPEN:
+		if (DoorContact_isClosed() && DoorContact_isSettled(Config_get()->doorSettleTime * (TICKS_PER_SECOND / 10))) {
+			if (doorAlarm) {
+				Buzzer_request(BUZZER_OWNER_DOOR, FALSE);
+				doorAlarm = FALSE;
+			}
+			Door_lock();
+		} else if (!doorAlarm && Tick_hasElapsed(doorStart, Config_get()->heldOpenTime * TICKS_PER_SECOND)) {
+			Buzzer_request(BUZZER_OWNER_DOOR, TRUE);
+			doorAlarm = TRUE;
+			sendDoorEvent(EVENT_DOOR_HELD);
+			AuditLog_record(AUDIT_EVENT_DOOR_HELD, AUDIT_USER_DEFAULT, AUDIT_RESULT_OK);
+		}
+		break;
+
+		/*---- Final Phase: Stop Motor ----*/
+	case DOOR_LOCKING:
+		if (Tick_hasElapsed(doorStart, Config_get()->lockingTime * TICKS_PER_SECOND)) {
+			Motor_rotate(MOTOR_STOP, 0);
+			doorState = DOOR_IDLE;
+			sendDoorEvent(EVENT_LOCKED);
+			PROFILE_END(PROFILE_DOOR_SEQUENCE);
+		}
+		break;
+	}
 }
 
-/*---- Global Variables ----*/
-uint8 failedAttempts = 0; /*---- Track failed password attempts ----*/
-uint8 command; /*---- Current UART command ----*/
+/*---- Trace the Door Contact Edges INT0 Handed Over, which Frees their Blocks ----*/
+void Door_logEdges(void) {
+	DoorContact_EdgeType edge;
+
+	while (DoorContact_takeEdge(&edge)) {
+		TRACE(TRACE_DOOR_EDGE, edge.closed, (uint8)edge.time);
+	}
+}
 
 /*---- Main Application Entry Point ----*/
 int main() {
+	CPU_CLOCK_CHECK_LIBRARY(); /*---- libCommon.a must be built for this clock ----*/
+
 	/*---- Initialize Peripherals ----*/
 	UART_init(&uart_config);
 	Motor_init();
 	Buzzer_init();
 	PIR_init();
 	TWI_init(&twi_config);
+	Storage_init(); /*---- Reconciles both EEPROM tiers ----*/
+	Config_init();  /*---- One block read, served from RAM from now on ----*/
+	applyConfig();
 	Enable_Global_Interrupt();
+	Tick_init();
+	DoorContact_init(); /*---- Stamps edges with the tick ----*/
+	Idle_init();
+	TRACE(TRACE_BOOT, 0, 0);
+#if PROFILE_ENABLE
+	Profile_init();
+#endif
+	Lockout_init(); /*---- Resumes a lockout that was running before a reset ----*/
+	AuditLog_init();
+	AuditLog_record(AUDIT_EVENT_BOOT, AUDIT_USER_DEFAULT, AUDIT_RESULT_OK);
+	if (Lockout_isActive()) {
+		AuditLog_record(AUDIT_EVENT_LOCKOUT, AUDIT_USER_DEFAULT, Lockout_remainingSeconds());
+	}
 
 	/*---- Password Storage Variables ----*/
-	uint8 storedPassword[PASSWORD_LENGTH], receivedPassword[PASSWORD_LENGTH], EEPROMPassword[PASSWORD_LENGTH];
+	const uint8* receivedPassword = request.payload;
+	uint8 length;
+	uint8 replaceAllowed;
+	RESPONSE_STATUS_PayloadType status;
+	RESPONSE_CONFIG_PayloadType configReply;
+	const CMD_DIGIT_PayloadType* digit = (const CMD_DIGIT_PayloadType*)request.payload;
+	const CMD_SET_CONFIG_PayloadType* setConfig = (const CMD_SET_CONFIG_PayloadType*)request.payload;
 
 	/*---- Main Command Processing Loop ----*/
 	while (1) {
-		command = UART_recieveByte();
+		Lockout_service(); /*---- Ends the lockout without blocking command handling ----*/
+		Door_service();    /*---- Requests keep being served while the door moves ----*/
+		Door_logEdges();
+
+		switch (Link_pollFrame(&request)) {
+		case LINK_FRAME_NONE:
+			salt_entropy++;
+			AuditLog_service(); /*---- EEPROM log writes and export frames only happen while idle ----*/
+			Idle_sleep();       /*---- Until the next tick or request byte ----*/
+			continue;
+
+		case LINK_FRAME_FRAMING_ERROR:
+			UART_setBaudRate(LINK_BASE_BAUD_RATE); /*---- The HMI restarted at the base rate ----*/
+			continue;
+
+		case LINK_FRAME_DROPPED:
+			TRACE(TRACE_UNEXPECTED, request.type, request.length);
+			continue;
+
+		case LINK_FRAME_READY:
+			break;
+		}
+		TRACE(TRACE_COMMAND, request.type, request.seq);
+
+		/*---- An HMI that missed this ECU's reset still uses its old rate and numbering.  ----*/
+		/*---- HMI commands are the codes below CMD_CHECK_INIT, debug commands above it    ----*/
+		/*---- keep working for a tool on a freshly reset board, all but the config write  ----*/
+		if (!linkUp && (request.type < CMD_CHECK_INIT || request.type == CMD_SET_CONFIG)) {
+			Link_sendFrame(RESPONSE_RESYNC, request.seq, NULL_PTR, 0);
+			continue;
+		}
+
+		/*---- A retransmission: the reply got lost, do not run the request twice ----*/
+		if (request.type == lastRequestType && request.seq == lastReply.seq) {
+			Link_sendFrame(lastReply.type, lastReply.seq, lastReply.payload, lastReply.length);
+			continue;
+		}
 
-		switch (command) {
+		/*---- A verified CMD_CHANGE_PASSWORD allows only the frame right after it to replace the password ----*/
+		replaceAllowed = changeVerified;
+		changeVerified = FALSE;
+
+		switch (request.type) {
 		/*---- Check Initialization Status ----*/
 		case CMD_CHECK_INIT:
-			UART_sendByte(IsPasswordStored());
+			UART_setBaudRate(LINK_BASE_BAUD_RATE); /*---- The HMI sends this at the base rate after a restart ----*/
+			lastRequestType = 0; /*---- A restarted HMI numbers its requests from 0 again ----*/
+			linkUp = TRUE;
+			UART_sendByte(storedPasswordLength() != 0);
+			Link_negotiateSlave(Config_get()->fastestRate);
+			break;
+
+			/*---- Link Check while the HMI Waits for Events ----*/
+		case CMD_HEARTBEAT:
+			sendResponse(RESPONSE_OK, request.seq);
+			break;
+
+			/*---- Typed Digit: Prefetch and Verify before ENTER ----*/
+		case CMD_DIGIT:
+			if (!Lockout_isActive()) {
+				speculateDigit(digit->index, digit->digit);
+			}
+			break; /*---- No reply, the request after ENTER carries the whole password ----*/
+
+			/*---- Report the Door and Lockout State ----*/
+		case CMD_STATUS:
+			status.doorState = doorState;
+			status.lockoutSeconds = Lockout_remainingSeconds();
+			sendReply(request.type, RESPONSE_STATUS, request.seq, (const uint8*)&status, sizeof(status));
 			break;
 
 			/*---- Password Creation Command ----*/
 		case CMD_CREATE_PASSWORD:
-			receivePassword(receivedPassword);
-			receivePassword(storedPassword); /*---- Reuse buffer for confirmation ----*/
+			/*---- Only the first password, or a new one right after the old one was verified ----*/
+			if (!replaceAllowed && storedPasswordLength() != 0) {
+				sendResponse(RESPONSE_ERROR, request.seq);
+				AuditLog_record(AUDIT_EVENT_PASSWORD_SET, AUDIT_USER_DEFAULT, AUDIT_RESULT_DENIED);
+				break;
+			}
+			length = Config_get()->passwordLength;
+			if (request.length != 2 * length) {
+				sendResponse(RESPONSE_ERROR, request.seq);
+				break;
+			}
 
-			if (comparePasswords(receivedPassword, storedPassword)) {
-				savePasswordToEEPROM(receivedPassword);
-				UART_sendByte(RESPONSE_OK);
+			if (SecureCompare_equal(receivedPassword, receivedPassword + length, length)) {
+				savePasswordToEEPROM(receivedPassword, length);
+				specState = SPEC_IDLE; /*---- A prefetched credential is stale now ----*/
+				sendResponse(RESPONSE_OK, request.seq);
+				AuditLog_record(AUDIT_EVENT_PASSWORD_SET, AUDIT_USER_DEFAULT, AUDIT_RESULT_OK);
 			} else {
-				UART_sendByte(RESPONSE_ERROR);
+				sendResponse(RESPONSE_ERROR, request.seq);
+				AuditLog_record(AUDIT_EVENT_PASSWORD_SET, AUDIT_USER_DEFAULT, AUDIT_RESULT_MISMATCH);
 			}
 			break;
 
 			/*---- Door Unlock Command ----*/
 		case CMD_OPEN_DOOR:
-			receivePassword(receivedPassword);
-			readPasswordFromEEPROM(EEPROMPassword);
+			if (doorState != DOOR_IDLE) {
+				sendResponse(RESPONSE_BUSY, request.seq); /*---- Not counted as an attempt ----*/
+				break;
+			}
+			/*---- No break: verified like a password change ----*/
 
-			if (comparePasswords(receivedPassword, EEPROMPassword)) {
-				UART_sendByte(RESPONSE_OK);
-				Door_Control_Sequence();
+			/*---- Password Change Command, the new password must follow as the next frame, a CMD_CREATE_PASSWORD ----*/
+		case CMD_CHANGE_PASSWORD:
+			if (request.length != storedPasswordLength()) {
+				sendResponse(RESPONSE_ERROR, request.seq);
+				break;
+			}
+
+			if (Lockout_isActive()) {
+				sendLockedResponse(request.seq); /*---- No verification while locked out ----*/
+				AuditLog_record(AUDIT_EVENT_AUTH_FAILURE, AUDIT_USER_DEFAULT, AUDIT_RESULT_LOCKED);
+				break;
+			}
+			if (checkCandidate(receivedPassword)) {
+				Lockout_recordSuccess();
+				sendResponse(RESPONSE_OK, request.seq);
+				if (request.type == CMD_CHANGE_PASSWORD) {
+					changeVerified = TRUE;
+				} else {
+					AuditLog_record(AUDIT_EVENT_UNLOCK, AUDIT_USER_DEFAULT, AUDIT_RESULT_OK); /*---- RAM only ----*/
+					Door_start(request.seq);
+				}
 			} else {
-				UART_sendByte(RESPONSE_ERROR);
-				failedAttempts++;
+				handleWrongPassword(request.seq);
 			}
 			break;
 
-			/*---- System Lockout Command ----*/
-		case CMD_LOCK_SYSTEM:
-			Buzzer_on();
-			Control_delaySeconds(LOCKOUT_TIME);
-			Buzzer_off();
-			failedAttempts = 0; /*---- Reset attempt counter ----*/
+			/*---- Report the Configuration and the Stored Password Length ----*/
+		case CMD_GET_CONFIG:
+			configReply.config = *Config_get();
+			configReply.storedLength = storedPasswordLength();
+			sendReply(request.type, RESPONSE_CONFIG, request.seq, (const uint8*)&configReply, sizeof(configReply));
 			break;
 
-			/*---- Password Change Command ----*/
-		case CMD_CHANGE_PASSWORD:
-			receivePassword(receivedPassword);
-			readPasswordFromEEPROM(EEPROMPassword);
-
-			if (comparePasswords(receivedPassword, EEPROMPassword)) {
-				UART_sendByte(RESPONSE_OK);
-				receivePassword(receivedPassword);
-				receivePassword(storedPassword);
+			/*---- Verify the Password Sent with it, then Validate, Store and Apply a New Configuration ----*/
+		case CMD_SET_CONFIG:
+			/*---- It sets the lockout itself, so it is never verified during one or without a password ----*/
+			length = storedPasswordLength();
+			if (length == 0 || request.length != sizeof(Config_Type) + length) {
+				sendResponse(RESPONSE_ERROR, request.seq);
+				break;
+			}
+			if (Lockout_isActive()) {
+				sendLockedResponse(request.seq);
+				AuditLog_record(AUDIT_EVENT_AUTH_FAILURE, AUDIT_USER_DEFAULT, AUDIT_RESULT_LOCKED);
+				break;
+			}
+			if (!checkCandidate(setConfig->password)) {
+				handleWrongPassword(request.seq); /*---- Counts towards the lockout like any other ----*/
+				break;
+			}
+			Lockout_recordSuccess();
 
-				if (comparePasswords(receivedPassword, storedPassword)) {
-					savePasswordToEEPROM(receivedPassword);
-					UART_sendByte(RESPONSE_OK);
-				} else {
-					UART_sendByte(RESPONSE_ERROR);
-				}
+			if (Config_set(&setConfig->config) == SUCCESS) {
+				applyConfig();
+				sendResponse(RESPONSE_OK, request.seq);
 			} else {
-				UART_sendByte(RESPONSE_ERROR);
-				failedAttempts++;
+				sendResponse(RESPONSE_ERROR, request.seq);
+			}
+			break;
+
+			/*---- Export the Audit Log, the Records Follow while Idle ----*/
+		case CMD_EXPORT_LOG:
+			AuditLog_export(request.seq);
+			break;
+
+#if HASH_BENCHMARK
+			/*---- Report Cycles to Verify a Candidate Password (LSB first) ----*/
+		case CMD_HASH_BENCHMARK: {
+			uint32 cycles = benchmarkVerification(receivedPassword);
+			RESPONSE_OK_PayloadType reply;
+			for (uint8 i = 0; i < sizeof(reply.cycles); i++) {
+				reply.cycles[i] = (uint8)(cycles >> (8 * i));
 			}
+			sendReply(request.type, RESPONSE_OK, request.seq, (const uint8*)&reply, sizeof(reply));
+			break;
+		}
+#endif
+#if PROFILE_ENABLE
+			/*---- Dump the Profiling Probes ----*/
+		case CMD_DUMP_PROFILE:
+			Profile_dump(request.seq);
+			break;
+#endif
+
+#if TRACE_ENABLE
+			/*---- Dump the Event Trace ----*/
+		case CMD_DUMP_TRACE:
+			Trace_dump(request.seq);
+			break;
+#endif
+
+			/*---- Dump the Block Pool Statistics ----*/
+		case CMD_DUMP_POOLS:
+			Pool_dump(request.seq);
 			break;
 		}
 	}
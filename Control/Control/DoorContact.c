@@ -0,0 +1,106 @@
+/******************************************************************************
+ *
+ * Module: Door Contact
+ *
+ * File Name: DoorContact.c
+ *
+ * Description: Source file for the door reed switch driver
+ *
+ * Every edge of the switch raises INT0, which stamps it with the tick. The
+ * interrupt also wakes the CPU from Idle_sleep, so the door sequence sees the
+ * door close within one pass of the main loop.
+ *
+ * The interrupt also hands each edge to the main loop: it takes a block from
+ * the edge pool, fills it in and queues the pointer. DoorContact_takeEdge
+ * copies it out and frees the block. The queue has a slot for every block,
+ * so a block that was taken can always be queued.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "DoorContact.h"
+#include "gpio.h"
+#include "tick.h"
+#include "pool.h"
+#include "queue.h"
+#include <avr/io.h> /* To use the external interrupt registers */
+#include <avr/interrupt.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+QUEUE_DEFINE(DoorContact_Edge, DoorContact_EdgeType *, DOOR_CONTACT_EDGE_BLOCKS)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static volatile Tick_Type g_lastEdge = 0;
+
+POOL_DEFINE(g_edgePool, DoorContact_EdgeType, DOOR_CONTACT_EDGE_BLOCKS);
+static DoorContact_Edge_QueueType g_edges;  /* INT0 to the main loop */
+
+/*******************************************************************************
+ *                       Interrupt Service Routines                            *
+ *******************************************************************************/
+
+ISR(INT0_vect)
+{
+    DoorContact_EdgeType *edge = Pool_alloc(&g_edgePool);
+
+    g_lastEdge = Tick_count; /* Interrupts are off here, the 4-byte read is safe */
+    if (edge != NULL_PTR)
+    {
+        edge->time = g_lastEdge;
+        edge->closed = DoorContact_isClosed();
+        DoorContact_Edge_push(&g_edges, edge);
+    }
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void DoorContact_init(void)
+{
+    GPIO_setupPinDirection(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID, PIN_INPUT);
+    GPIO_writePin(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID, LOGIC_HIGH); /* Pull-up */
+
+    g_lastEdge = Tick_get();
+    Pool_init(&g_edgePool);
+    MCUCR = (MCUCR & ~((1 << ISC01) | (1 << ISC00))) | (1 << ISC00); /* Any logical change */
+    GIFR = (1 << INTF0); /* Drop an edge the pull-up caused */
+    GICR |= (1 << INT0);
+}
+
+uint8 DoorContact_isClosed(void)
+{
+    return (GPIO_readPin(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID) == DOOR_CONTACT_CLOSED_LEVEL) ? TRUE : FALSE;
+}
+
+uint8 DoorContact_isSettled(uint16 settle_ms)
+{
+    Tick_Type lastEdge;
+    uint8 sreg = SREG;
+
+    cli();
+    lastEdge = g_lastEdge;
+    SREG = sreg;
+
+    return Tick_hasElapsed(lastEdge, settle_ms);
+}
+
+uint8 DoorContact_takeEdge(DoorContact_EdgeType *edge)
+{
+    DoorContact_EdgeType *block;
+
+    if (!DoorContact_Edge_pop(&g_edges, &block))
+    {
+        return FALSE;
+    }
+    *edge = *block;
+    Pool_free(&g_edgePool, block);
+    return TRUE;
+}
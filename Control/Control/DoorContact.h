@@ -0,0 +1,72 @@
+/******************************************************************************
+ *
+ * Module: Door Contact
+ *
+ * File Name: DoorContact.h
+ *
+ * Description: Header file for the door reed switch driver
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef DOORCONTACT_H_
+#define DOORCONTACT_H_
+
+#include "board_config.h" /* Reed switch pin */
+#include "std_types.h"
+#include "tick.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Edges that can wait for the main loop. A longer burst of bounces is still
+ * stamped for DoorContact_isSettled, only its log entries are lost and
+ * counted as failures of the pool (CMD_DUMP_POOLS).
+ */
+#define DOOR_CONTACT_EDGE_BLOCKS    4
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct {
+    Tick_Type time;         /* Tick the edge was seen at */
+    uint8 closed;           /* Level after the edge, TRUE: door shut */
+} DoorContact_EdgeType;
+
+/*******************************************************************************
+ *                              Function Prototypes                            *
+ *******************************************************************************/
+
+/*
+ * Description:
+ * Set the reed switch pin as input with its pull-up, and enable INT0 on both
+ * edges. Lists the edge pool for Pool_dump. Needs Tick_init first.
+ */
+void DoorContact_init(void);
+
+/*
+ * Description:
+ * TRUE while the magnet closes the switch, i.e. the door is shut. A broken
+ * wire reads as open.
+ */
+uint8 DoorContact_isClosed(void);
+
+/*
+ * Description:
+ * TRUE once the contact has not changed for settle_ms, so a bouncing switch
+ * or a door swinging back is not taken as closed.
+ */
+uint8 DoorContact_isSettled(uint16 settle_ms);
+
+/*
+ * Description:
+ * Copy out the oldest edge the interrupt handed over and free its block.
+ * Returns FALSE when none is waiting. Main loop only.
+ */
+uint8 DoorContact_takeEdge(DoorContact_EdgeType *edge);
+
+#endif /* DOORCONTACT_H_ */
@@ -9,7 +9,7 @@
 #define MOTOR_H_
 
 #include "std_types.h"
-#include "gpio.h"
+#include "board_config.h" /* Motor pins */
 
 /* Enum for DC Motor states */
 typedef enum {
@@ -18,12 +18,6 @@ typedef enum {
     MOTOR_STOP
 } DcMotor_State;
 
-/* Motor Configuration */
-#define MOTOR_IN1_PORT_ID  PORTD_ID
-#define MOTOR_IN1_PIN_ID   PIN6_ID
-#define MOTOR_IN2_PORT_ID  PORTD_ID
-#define MOTOR_IN2_PIN_ID   PIN7_ID
-
 /* Function Declarations */
 void Motor_init(void);
 void Motor_rotate(DcMotor_State state, uint8 speed);
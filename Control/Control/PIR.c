@@ -1,4 +1,4 @@
-#include "pir.h"
+#include "PIR.h"
 #include "gpio.h"
 #include "common_macros.h"
 
@@ -1,16 +1,9 @@
 #ifndef PIR_H_
 #define PIR_H_
 
-#include "gpio.h"
+#include "board_config.h" /* PIR pin (update there if hardware changes) */
 #include "std_types.h"
 
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-/* PIR Sensor Connection (Update these if hardware changes) */
-#define PIR_PORT_ID     PORTC_ID
-#define PIR_PIN_ID      PIN2_ID
-
 /*******************************************************************************
  *                              Function Prototypes                            *
  *******************************************************************************/
@@ -8,6 +8,10 @@
 #include "PWM.h"
 #include "common_macros.h"
 #include "std_types.h"
+#include "timer.h"
+
+TIMER_CLAIM(TIMER0);                /* Programmed directly, not through timer.c */
+TIMER_CLAIM_CHANNEL(TIMER0, OC0);   /* PB3 */
 
 void PWM_Timer0_Start(uint8 duty_cycle)
 {
@@ -22,7 +26,7 @@ void PWM_Timer0_Start(uint8 duty_cycle)
 	 * 1. Fast PWM mode FOC0=0
 	 * 2. Fast PWM Mode WGM01=1 & WGM00=1
 	 * 3. Clear OC0 when match occurs (non inverted mode) COM00=0 & COM01=1
-	 * 4. clock = F_CPU/1024 CS00=1 CS01=0 CS02=1
+	 * 4. clock = F_CPU/prescaler from PWM_CLOCK_SELECT (PWM.h)
 	 */
-	TCCR0 = (1<<WGM00) | (1<<WGM01) | (1<<COM01) | (1<<CS01);
+	TCCR0 = (1<<WGM00) | (1<<WGM01) | (1<<COM01) | PWM_CLOCK_SELECT;
 }
@@ -9,12 +9,26 @@
 #define PWM_H_
 
 #include "std_types.h"
-#include "gpio.h"
+#include "cpu_clock.h"
+#include "board_config.h" /* PWM output pin */
 
 #define TIMER_INITIAL_VALUE 0
 
-#define PWM_PORT_ID PORTB_ID
-#define PWN_PIN_ID	PIN3_ID
+/*
+ * Fast PWM runs at F_CPU / (prescaler * 256). The smallest prescaler that
+ * keeps it at or below PWM_MAX_FREQUENCY is used: 3.9kHz at 8MHz, 7.8kHz at 16MHz.
+ */
+#define PWM_MAX_FREQUENCY   10000UL
+
+#if (F_CPU / 256UL) <= PWM_MAX_FREQUENCY
+#define PWM_CLOCK_SELECT    (1<<CS00)                /* F_CPU/1 */
+#elif (F_CPU / (8UL * 256UL)) <= PWM_MAX_FREQUENCY
+#define PWM_CLOCK_SELECT    (1<<CS01)                /* F_CPU/8 */
+#elif (F_CPU / (64UL * 256UL)) <= PWM_MAX_FREQUENCY
+#define PWM_CLOCK_SELECT    ((1<<CS01) | (1<<CS00))  /* F_CPU/64 */
+#else
+#error "F_CPU too fast for the motor PWM"
+#endif
 
 void PWM_Timer0_Start(uint8 duty_cycle);
 
@@ -0,0 +1,63 @@
+################################################################################
+# Automatically-generated file. Do not edit!
+################################################################################
+
+# Add inputs and outputs from these tool invocations to the build variables 
+C_SRCS += \
+../Buzzer.c \
+../Control_App.c \
+../DoorContact.c \
+../Motor.c \
+../PIR.c \
+../PWM.c \
+../audit_log.c \
+../blake2s.c \
+../config_store.c \
+../external_eeprom.c \
+../lockout.c \
+../secure_compare.c \
+../storage.c \
+../twi.c 
+
+OBJS += \
+./Buzzer.o \
+./Control_App.o \
+./DoorContact.o \
+./Motor.o \
+./PIR.o \
+./PWM.o \
+./audit_log.o \
+./blake2s.o \
+./config_store.o \
+./external_eeprom.o \
+./lockout.o \
+./secure_compare.o \
+./storage.o \
+./twi.o 
+
+C_DEPS += \
+./Buzzer.d \
+./Control_App.d \
+./DoorContact.d \
+./Motor.d \
+./PIR.d \
+./PWM.d \
+./audit_log.d \
+./blake2s.d \
+./config_store.d \
+./external_eeprom.d \
+./lockout.d \
+./secure_compare.d \
+./storage.d \
+./twi.d 
+
+
+# Each subdirectory must supply rules for building sources it contributes
+%.o: ../%.c subdir.mk
+	@echo 'Building file: $<'
+	@echo 'Invoking: AVR Compiler'
+	avr-gcc -Wall -Os -flto -ffat-lto-objects -mrelax -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -I"../../../Common/Common" -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	@echo 'Finished building: $<'
+	@echo ' '
+
+
@@ -0,0 +1,211 @@
+/******************************************************************************
+ *
+ * Module: Audit Log
+ *
+ * File Name: audit_log.c
+ *
+ * Description: Source file for the EEPROM-backed circular audit event log
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "audit_log.h"
+#include "storage.h"
+#include "link.h"
+#include "protocol.h"
+#include "tick.h"
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define AUDIT_RECORD_SIZE           sizeof(AuditLog_RecordType)
+#define AUDIT_RECORDS_PER_PAGE      (EEPROM_PAGE_SIZE / AUDIT_RECORD_SIZE)
+
+/* The region starts on a page boundary, so ring slots map to pages */
+#define AUDIT_RECORD_OFFSET(index)  ((uint16)(index) * AUDIT_RECORD_SIZE)
+
+_Static_assert(sizeof(AuditLog_RecordType) == PROTOCOL_AUDIT_RECORD_SIZE, "RESPONSE_AUDIT carries records as stored");
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static AuditLog_RecordType g_staging[AUDIT_LOG_STAGING_SIZE];
+static uint8 g_staged = 0;
+static Tick_Type g_stagedSince;
+
+static uint8 g_head = 0;    /* Next ring slot to write */
+static uint8 g_count = 0;   /* Records stored in EEPROM */
+static uint8 g_seq = 0;     /* Sequence number of the next record */
+
+static uint8 g_exportIndex;     /* Ring slot of the next record to send */
+static uint8 g_exportLeft = 0;  /* Records still to send, 0: no export running */
+static uint8 g_exportSeq;       /* Sequence number of the export request */
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Write count records to the ring starting at the head, wrapping at the end */
+static void AuditLog_writeRecords(const AuditLog_RecordType *records, uint8 count)
+{
+    uint8 chunk = AUDIT_LOG_CAPACITY - g_head;
+
+    if (chunk > count)
+    {
+        chunk = count;
+    }
+
+    Storage_writeRegion(STORAGE_KEY_AUDIT_LOG, AUDIT_RECORD_OFFSET(g_head), records, chunk * AUDIT_RECORD_SIZE);
+    if (count > chunk)
+    {
+        Storage_writeRegion(STORAGE_KEY_AUDIT_LOG, AUDIT_RECORD_OFFSET(0), &records[chunk], (count - chunk) * AUDIT_RECORD_SIZE);
+    }
+
+    g_head = (g_head + count) % AUDIT_LOG_CAPACITY;
+    g_count = (g_count + count > AUDIT_LOG_CAPACITY) ? AUDIT_LOG_CAPACITY : (g_count + count);
+}
+
+/* Send the next RESPONSE_AUDIT frame of the running export */
+static void AuditLog_exportNext(void)
+{
+    RESPONSE_AUDIT_PayloadType frame;
+    uint8 n = PROTOCOL_AUDIT_RECORDS;
+
+    if (n > g_exportLeft)
+    {
+        n = g_exportLeft;
+    }
+    if (n > AUDIT_LOG_CAPACITY - g_exportIndex)
+    {
+        n = AUDIT_LOG_CAPACITY - g_exportIndex;  /* Split the read at the end of the ring */
+    }
+
+    if (Storage_readRegion(STORAGE_KEY_AUDIT_LOG, AUDIT_RECORD_OFFSET(g_exportIndex), frame.records,
+            n * AUDIT_RECORD_SIZE) == ERROR)
+    {
+        /* Keep the announced length, the reader sees empty records */
+        memset(frame.records, AUDIT_EVENT_EMPTY, sizeof(frame.records));
+    }
+    Link_sendFrame(RESPONSE_AUDIT, g_exportSeq, frame.records, n * AUDIT_RECORD_SIZE);
+
+    g_exportIndex = (g_exportIndex + n) % AUDIT_LOG_CAPACITY;
+    g_exportLeft -= n;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void AuditLog_init(void)
+{
+    AuditLog_RecordType record;
+    uint8 prevSeq = 0;
+    uint8 i;
+
+    g_head = 0;
+    g_count = AUDIT_LOG_CAPACITY;
+
+    /*
+     * Records are written in sequence order, so the head is the first slot
+     * that is either still erased or does not continue the sequence of the
+     * slot before it. If no such slot exists the ring wrapped exactly at 0.
+     */
+    for (i = 0; i < AUDIT_LOG_CAPACITY; i++)
+    {
+        if (Storage_readRegion(STORAGE_KEY_AUDIT_LOG, AUDIT_RECORD_OFFSET(i), &record, AUDIT_RECORD_SIZE) == ERROR)
+        {
+            g_count = 0;
+            return;
+        }
+
+        if (record.event == AUDIT_EVENT_EMPTY)
+        {
+            g_head = i;
+            g_count = i;    /* Never wrapped */
+            break;
+        }
+
+        if ((i > 0) && (record.seq != (uint8)(prevSeq + 1)))
+        {
+            g_head = i;     /* Older lap starts here */
+            break;
+        }
+
+        prevSeq = record.seq;
+    }
+
+    g_seq = (g_head == 0 && g_count == 0) ? 0 : (uint8)(prevSeq + 1);
+}
+
+void AuditLog_record(AuditLog_EventType event, uint8 user, uint8 result)
+{
+    AuditLog_RecordType *record;
+
+    if (g_staged == AUDIT_LOG_STAGING_SIZE)
+    {
+        AuditLog_flush();  /* Only if events arrive faster than the main loop idles */
+    }
+
+    if (g_staged == 0)
+    {
+        g_stagedSince = Tick_get();
+    }
+
+    record = &g_staging[g_staged++];
+    record->timestamp = Tick_get();
+    record->event = event;
+    record->user = user;
+    record->result = result;
+    record->seq = g_seq++;
+}
+
+void AuditLog_service(void)
+{
+    uint8 pageRoom;
+
+    if (g_exportLeft != 0)
+    {
+        AuditLog_exportNext();  /* Staged records wait, the page write would stall the export */
+        return;
+    }
+
+    if (g_staged == 0)
+    {
+        return;
+    }
+
+    /* Write whole pages only, unless a partial page has waited too long */
+    pageRoom = AUDIT_RECORDS_PER_PAGE - (g_head % AUDIT_RECORDS_PER_PAGE);
+    if ((g_staged >= pageRoom) || Tick_hasElapsed(g_stagedSince, AUDIT_LOG_FLUSH_DELAY))
+    {
+        AuditLog_flush();
+    }
+}
+
+void AuditLog_flush(void)
+{
+    if (g_staged != 0)
+    {
+        AuditLog_writeRecords(g_staging, g_staged);
+        g_staged = 0;
+    }
+}
+
+void AuditLog_export(uint8 seq)
+{
+    Protocol_AuditHeaderType header;
+
+    AuditLog_flush();
+
+    /* Oldest record sits at the head once the ring has wrapped */
+    g_exportIndex = (g_count == AUDIT_LOG_CAPACITY) ? g_head : 0;
+    g_exportLeft = g_count;
+    g_exportSeq = seq;
+
+    header.count = g_count;
+    Link_sendFrame(RESPONSE_AUDIT, seq, (const uint8 *)&header, sizeof(header));
+}
@@ -0,0 +1,105 @@
+/******************************************************************************
+ *
+ * Module: Audit Log
+ *
+ * File Name: audit_log.h
+ *
+ * Description: Header file for the EEPROM-backed circular audit event log
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef AUDIT_LOG_H_
+#define AUDIT_LOG_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* STORAGE_KEY_AUDIT_LOG, the upper 1 KB of the 24C16, holds the ring of 8-byte records */
+#define AUDIT_LOG_CAPACITY          128
+
+/* Records are kept in RAM and written out a page at a time */
+#define AUDIT_LOG_STAGING_SIZE      4
+#define AUDIT_LOG_FLUSH_DELAY       2000   /* ms a partial page may wait in RAM */
+
+#define AUDIT_USER_DEFAULT          0      /* Single password system: one user slot */
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum {
+    AUDIT_EVENT_BOOT           = 0x01,
+    AUDIT_EVENT_UNLOCK         = 0x02,
+    AUDIT_EVENT_AUTH_FAILURE   = 0x03,
+    AUDIT_EVENT_LOCKOUT        = 0x04,  /* result = lockout seconds */
+    AUDIT_EVENT_PIR_HOLD       = 0x05,
+    AUDIT_EVENT_PASSWORD_SET   = 0x06,
+    AUDIT_EVENT_DOOR_HELD      = 0x07,  /* Open past the configured time */
+    AUDIT_EVENT_EMPTY          = 0xFF   /* Erased EEPROM */
+} AuditLog_EventType;
+
+typedef enum {
+    AUDIT_RESULT_OK             = 0x00,
+    AUDIT_RESULT_WRONG_PASSWORD = 0x01,
+    AUDIT_RESULT_LOCKED         = 0x02,
+    AUDIT_RESULT_MISMATCH       = 0x03,
+    AUDIT_RESULT_DENIED         = 0x04  /* Password set without the old one verified first */
+} AuditLog_ResultType;
+
+/* 8-byte record as stored in EEPROM and sent by the export command */
+typedef struct {
+    uint32 timestamp;   /* Tick at the event, ms since boot */
+    uint8  event;       /* AuditLog_EventType */
+    uint8  user;        /* User slot */
+    uint8  result;      /* AuditLog_ResultType, or event specific */
+    uint8  seq;         /* Increments per record, finds the ring head at boot */
+} AuditLog_RecordType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Scan the EEPROM ring for the newest record so logging continues after it.
+ */
+void AuditLog_init(void);
+
+/*
+ * Description :
+ * Log an event. Only copies into the RAM staging buffer, so it is safe to
+ * call on time critical paths.
+ */
+void AuditLog_record(AuditLog_EventType event, uint8 user, uint8 result);
+
+/*
+ * Description :
+ * Call from the main loop when idle. While an export runs it sends the next
+ * RESPONSE_AUDIT frame. Otherwise it writes staged records once a page is
+ * full or the oldest one has waited AUDIT_LOG_FLUSH_DELAY.
+ */
+void AuditLog_service(void);
+
+/*
+ * Description :
+ * Write every staged record to EEPROM now.
+ */
+void AuditLog_flush(void);
+
+/*
+ * Description :
+ * Start an export with sequence number seq: send a RESPONSE_AUDIT frame with
+ * a Protocol_AuditHeaderType. AuditLog_service then sends the records oldest
+ * first, PROTOCOL_AUDIT_RECORDS a frame, one frame per call, so the door is
+ * still served during the export. Records that a wrapping ring overwrites
+ * before they are sent are sent as they now read. An export started while
+ * one runs replaces it.
+ */
+void AuditLog_export(uint8 seq);
+
+#endif /* AUDIT_LOG_H_ */
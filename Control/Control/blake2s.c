@@ -0,0 +1,188 @@
+/******************************************************************************
+ *
+ * Module: BLAKE2s
+ *
+ * File Name: blake2s.c
+ *
+ * Description: Source file for the BLAKE2s hash (RFC 7693)
+ *
+ * BLAKE2s is used instead of SHA-256 because its rotations by 16 and 8 are
+ * plain byte moves on the AVR, and it needs 10 rounds instead of 64.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "blake2s.h"
+#include <string.h>
+#include <avr/pgmspace.h> /* To keep the constants and the message schedule in flash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BLAKE2S_ROUNDS  10
+
+#define ROTR32(x, n)    (((x) >> (n)) | ((x) << (32 - (n))))
+
+/*
+ * The G mixing function. It is a macro so the whole round is unrolled with
+ * every state word held in a local the compiler can keep in registers.
+ */
+#define G(a, b, c, d, x, y)            \
+    do {                               \
+        a += b + (x);                  \
+        d = ROTR32(d ^ a, 16);         \
+        c += d;                        \
+        b = ROTR32(b ^ c, 12);         \
+        a += b + (y);                  \
+        d = ROTR32(d ^ a, 8);          \
+        c += d;                        \
+        b = ROTR32(b ^ c, 7);          \
+    } while (0)
+
+/*******************************************************************************
+ *                           Private Constants                                 *
+ *******************************************************************************/
+
+static const uint32 BLAKE2s_IV[8] PROGMEM = {
+    0x6A09E667UL, 0xBB67AE85UL, 0x3C6EF372UL, 0xA54FF53AUL,
+    0x510E527FUL, 0x9B05688CUL, 0x1F83D9ABUL, 0x5BE0CD19UL
+};
+
+#define IV(i)   pgm_read_dword(&BLAKE2s_IV[i])
+
+/* Message word permutation of every round */
+static const uint8 BLAKE2s_sigma[BLAKE2S_ROUNDS][16] PROGMEM = {
+    {  0,  1,  2,  3,  4,  5,  6,  7,  8,  9, 10, 11, 12, 13, 14, 15 },
+    { 14, 10,  4,  8,  9, 15, 13,  6,  1, 12,  0,  2, 11,  7,  5,  3 },
+    { 11,  8, 12,  0,  5,  2, 15, 13, 10, 14,  3,  6,  7,  1,  9,  4 },
+    {  7,  9,  3,  1, 13, 12, 11, 14,  2,  6,  5, 10,  4,  0, 15,  8 },
+    {  9,  0,  5,  7,  2,  4, 10, 15, 14,  1, 11, 12,  6,  8,  3, 13 },
+    {  2, 12,  6, 10,  0, 11,  8,  3,  4, 13,  7,  5, 15, 14,  1,  9 },
+    { 12,  5,  1, 15, 14, 13,  4, 10,  0,  7,  6,  3,  9,  2,  8, 11 },
+    { 13, 11,  7, 14, 12,  1,  3,  9,  5,  0, 15,  4,  8,  6,  2, 10 },
+    {  6, 15, 14,  9, 11,  3,  0,  8, 12,  2, 13,  7,  1,  4, 10,  5 },
+    { 10,  2,  8,  4,  7,  6,  1,  5, 15, 11,  9, 14,  3, 12, 13,  0 }
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void BLAKE2s_compress(BLAKE2s_ContextType *ctx, uint8 last)
+{
+    uint32 m[16];
+    uint32 v0, v1, v2, v3, v4, v5, v6, v7, v8, v9, v10, v11, v12, v13, v14, v15;
+    const uint8 *s;
+    uint8 round;
+
+    /* BLAKE2s words are little-endian, the same as the AVR memory layout */
+    memcpy(m, ctx->buf, BLAKE2S_BLOCK_SIZE);
+
+    v0 = ctx->h[0]; v1 = ctx->h[1]; v2 = ctx->h[2]; v3 = ctx->h[3];
+    v4 = ctx->h[4]; v5 = ctx->h[5]; v6 = ctx->h[6]; v7 = ctx->h[7];
+    v8  = IV(0); v9  = IV(1);
+    v10 = IV(2); v11 = IV(3);
+    v12 = IV(4) ^ ctx->t;
+    v13 = IV(5);            /* High word of the counter is always 0 */
+    v14 = last ? ~IV(6) : IV(6);
+    v15 = IV(7);
+
+    for (round = 0; round < BLAKE2S_ROUNDS; round++)
+    {
+        s = BLAKE2s_sigma[round];
+
+        /* Columns */
+        G(v0, v4,  v8, v12, m[pgm_read_byte(&s[0])],  m[pgm_read_byte(&s[1])]);
+        G(v1, v5,  v9, v13, m[pgm_read_byte(&s[2])],  m[pgm_read_byte(&s[3])]);
+        G(v2, v6, v10, v14, m[pgm_read_byte(&s[4])],  m[pgm_read_byte(&s[5])]);
+        G(v3, v7, v11, v15, m[pgm_read_byte(&s[6])],  m[pgm_read_byte(&s[7])]);
+
+        /* Diagonals */
+        G(v0, v5, v10, v15, m[pgm_read_byte(&s[8])],  m[pgm_read_byte(&s[9])]);
+        G(v1, v6, v11, v12, m[pgm_read_byte(&s[10])], m[pgm_read_byte(&s[11])]);
+        G(v2, v7,  v8, v13, m[pgm_read_byte(&s[12])], m[pgm_read_byte(&s[13])]);
+        G(v3, v4,  v9, v14, m[pgm_read_byte(&s[14])], m[pgm_read_byte(&s[15])]);
+    }
+
+    ctx->h[0] ^= v0 ^ v8;
+    ctx->h[1] ^= v1 ^ v9;
+    ctx->h[2] ^= v2 ^ v10;
+    ctx->h[3] ^= v3 ^ v11;
+    ctx->h[4] ^= v4 ^ v12;
+    ctx->h[5] ^= v5 ^ v13;
+    ctx->h[6] ^= v6 ^ v14;
+    ctx->h[7] ^= v7 ^ v15;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void BLAKE2s_init(BLAKE2s_ContextType *ctx, uint8 digest_len)
+{
+    uint8 i;
+
+    for (i = 0; i < 8; i++)
+    {
+        ctx->h[i] = IV(i);
+    }
+
+    /* Parameter block: digest length, no key, fanout = depth = 1 */
+    ctx->h[0] ^= 0x01010000UL ^ digest_len;
+    ctx->t = 0;
+    ctx->buf_len = 0;
+    ctx->digest_len = digest_len;
+}
+
+void BLAKE2s_update(BLAKE2s_ContextType *ctx, const uint8 *data, uint16 len)
+{
+    uint8 chunk;
+
+    while (len > 0)
+    {
+        /* The last block must be compressed by BLAKE2s_final, so only flush when more input follows */
+        if (ctx->buf_len == BLAKE2S_BLOCK_SIZE)
+        {
+            ctx->t += BLAKE2S_BLOCK_SIZE;
+            BLAKE2s_compress(ctx, FALSE);
+            ctx->buf_len = 0;
+        }
+
+        chunk = BLAKE2S_BLOCK_SIZE - ctx->buf_len;
+        if (chunk > len)
+        {
+            chunk = (uint8)len;
+        }
+
+        memcpy(&ctx->buf[ctx->buf_len], data, chunk);
+        ctx->buf_len += chunk;
+        data += chunk;
+        len -= chunk;
+    }
+}
+
+void BLAKE2s_final(BLAKE2s_ContextType *ctx, uint8 *digest)
+{
+    uint8 i;
+
+    ctx->t += ctx->buf_len;
+    memset(&ctx->buf[ctx->buf_len], 0, BLAKE2S_BLOCK_SIZE - ctx->buf_len);
+    BLAKE2s_compress(ctx, TRUE);
+
+    /* Output the state little-endian, truncated to the requested length */
+    for (i = 0; i < ctx->digest_len; i++)
+    {
+        digest[i] = (uint8)(ctx->h[i >> 2] >> ((i & 3) << 3));
+    }
+}
+
+void BLAKE2s_hash(uint8 *digest, uint8 digest_len, const uint8 *data, uint16 len)
+{
+    BLAKE2s_ContextType ctx;
+
+    BLAKE2s_init(&ctx, digest_len);
+    BLAKE2s_update(&ctx, data, len);
+    BLAKE2s_final(&ctx, digest);
+}
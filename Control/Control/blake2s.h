@@ -0,0 +1,66 @@
+/******************************************************************************
+ *
+ * Module: BLAKE2s
+ *
+ * File Name: blake2s.h
+ *
+ * Description: Header file for the BLAKE2s hash (RFC 7693) used to store
+ *              salted password digests
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef BLAKE2S_H_
+#define BLAKE2S_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BLAKE2S_BLOCK_SIZE          64
+#define BLAKE2S_MAX_DIGEST_SIZE     32
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct {
+    uint32 h[8];                     /* Chained state */
+    uint32 t;                        /* Bytes hashed so far (messages < 4 GB) */
+    uint8  buf[BLAKE2S_BLOCK_SIZE];  /* Pending input block */
+    uint8  buf_len;
+    uint8  digest_len;
+} BLAKE2s_ContextType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Start an unkeyed hash producing digest_len bytes (1 .. BLAKE2S_MAX_DIGEST_SIZE).
+ */
+void BLAKE2s_init(BLAKE2s_ContextType *ctx, uint8 digest_len);
+
+/*
+ * Description :
+ * Absorb len bytes of input, may be called any number of times.
+ */
+void BLAKE2s_update(BLAKE2s_ContextType *ctx, const uint8 *data, uint16 len);
+
+/*
+ * Description :
+ * Compress the last block and write the digest.
+ */
+void BLAKE2s_final(BLAKE2s_ContextType *ctx, uint8 *digest);
+
+/*
+ * Description :
+ * One-shot helper: digest = BLAKE2s(data[0 .. len-1]).
+ */
+void BLAKE2s_hash(uint8 *digest, uint8 digest_len, const uint8 *data, uint16 len);
+
+#endif /* BLAKE2S_H_ */
@@ -0,0 +1,45 @@
+/******************************************************************************
+ *
+ * Module: Board Configuration
+ *
+ * File Name: board_config.h
+ *
+ * Description: Pin assignment of the Control_ECU board. The shared drivers in
+ *              Common/Common are board independent; everything wired
+ *              differently per board lives here.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef BOARD_CONFIG_H_
+#define BOARD_CONFIG_H_
+
+#include "gpio.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* H-bridge direction inputs */
+#define MOTOR_IN1_PORT_ID  PORTD_ID
+#define MOTOR_IN1_PIN_ID   PIN6_ID
+#define MOTOR_IN2_PORT_ID  PORTD_ID
+#define MOTOR_IN2_PIN_ID   PIN7_ID
+
+/* H-bridge enable, driven by OC0 */
+#define PWM_PORT_ID        PORTB_ID
+#define PWN_PIN_ID         PIN3_ID
+
+#define BUZZER_PORT_ID     PORTC_ID
+#define BUZZER_PIN_ID      PIN7_ID
+
+#define PIR_PORT_ID        PORTC_ID
+#define PIR_PIN_ID         PIN2_ID
+
+/* Door reed switch to ground on INT0, closed by the magnet when the door is shut */
+#define DOOR_CONTACT_PORT_ID       PORTD_ID
+#define DOOR_CONTACT_PIN_ID        PIN2_ID
+#define DOOR_CONTACT_CLOSED_LEVEL  LOGIC_LOW
+
+#endif /* BOARD_CONFIG_H_ */
@@ -0,0 +1,91 @@
+/******************************************************************************
+ *
+ * Module: Configuration Store
+ *
+ * File Name: config_store.c
+ *
+ * Description: Source file for the configuration record
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "config_store.h"
+#include "storage.h"
+#include "link.h"
+#include "twi.h"
+
+/* Storage_read copies the record straight into the struct */
+_Static_assert(sizeof(Config_Type) == STORAGE_CONFIG_SIZE, "Config_Type does not match STORAGE_CONFIG_SIZE");
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* RAM mirror of the stored block */
+static Config_Type g_config = {
+    .version        = CONFIG_VERSION,
+    .lockingTime    = CONFIG_DEFAULT_LOCKING_TIME,
+    .lockoutTime    = CONFIG_DEFAULT_LOCKOUT_TIME,
+    .maxAttempts    = CONFIG_DEFAULT_MAX_ATTEMPTS,
+    .passwordLength = CONFIG_DEFAULT_PASSWORD_LENGTH,
+    .twiBitRate     = CONFIG_DEFAULT_TWI_BIT_RATE,
+    .fastestRate    = CONFIG_DEFAULT_FASTEST_RATE,
+    .doorSettleTime = CONFIG_DEFAULT_DOOR_SETTLE_TIME,
+    .heldOpenTime   = CONFIG_DEFAULT_HELD_OPEN_TIME,
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint8 Config_isValid(const Config_Type *config)
+{
+    return (config->version == CONFIG_VERSION)
+            && (config->lockingTime >= 1) && (config->lockingTime <= CONFIG_MAX_LOCKING_TIME)
+            && (config->lockoutTime >= 1) && (config->lockoutTime <= CONFIG_MAX_LOCKOUT_TIME)
+            && (config->maxAttempts >= 1) && (config->maxAttempts <= CONFIG_MAX_ATTEMPTS)
+            && (config->passwordLength >= PASSWORD_MIN_LENGTH) && (config->passwordLength <= PASSWORD_MAX_LENGTH)
+            && (config->twiBitRate >= TWI_DEFAULT_BIT_RATE)     /* Lower TWBR: SCL above 400kHz at this F_CPU */
+            && (config->fastestRate <= LINK_BASE_RATE_INDEX)
+            && (config->doorSettleTime >= 1) && (config->doorSettleTime <= CONFIG_MAX_DOOR_SETTLE_TIME)
+            && (config->heldOpenTime >= 1) && (config->heldOpenTime <= CONFIG_MAX_HELD_OPEN_TIME);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Config_init(void)
+{
+    Config_Type stored;
+
+    if (Storage_read(STORAGE_KEY_CONFIG, &stored) == SUCCESS)
+    {
+        /* A record saved by a build with a slower clock would overclock the bus, slow it down */
+        if (stored.twiBitRate < TWI_DEFAULT_BIT_RATE)
+        {
+            stored.twiBitRate = TWI_DEFAULT_BIT_RATE;
+        }
+        if (Config_isValid(&stored))
+        {
+            g_config = stored;
+        }
+    }
+}
+
+const Config_Type *Config_get(void)
+{
+    return &g_config;
+}
+
+uint8 Config_set(const Config_Type *config)
+{
+    if (!Config_isValid(config) || Storage_write(STORAGE_KEY_CONFIG, config) == ERROR)
+    {
+        return ERROR;
+    }
+
+    g_config = *config;
+    return SUCCESS;
+}
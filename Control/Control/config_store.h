@@ -0,0 +1,45 @@
+/******************************************************************************
+ *
+ * Module: Configuration Store
+ *
+ * File Name: config_store.h
+ *
+ * Description: Header file for the configuration record. It is read from
+ *              EEPROM once at boot and served from RAM afterwards.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef CONFIG_STORE_H_
+#define CONFIG_STORE_H_
+
+#include "config.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Load the stored configuration into RAM. A block that is missing, fails its
+ * CRC, has another version or holds values out of range leaves the defaults.
+ * A TWI bit rate too fast for this F_CPU is raised to TWI_DEFAULT_BIT_RATE.
+ * Needs Storage_init first.
+ */
+void Config_init(void);
+
+/*
+ * Description :
+ * The configuration in use.
+ */
+const Config_Type *Config_get(void);
+
+/*
+ * Description :
+ * Check a new configuration, store it and use it from now on. Returns ERROR
+ * and keeps the old one if a field is out of range or the write failed.
+ */
+uint8 Config_set(const Config_Type *config);
+
+#endif /* CONFIG_STORE_H_ */
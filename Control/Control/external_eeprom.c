@@ -80,3 +80,108 @@ uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
 
     return SUCCESS;
 }
+
+/*
+ * Description :
+ * Address the device for a write of u16addr. A 24Cxx does not ACK its slave
+ * address while an internal write cycle is running, so keep restarting until
+ * it does (ACK polling) and then send the memory location address.
+ */
+static uint8 EEPROM_selectAddress(uint16 u16addr)
+{
+    uint16 retries = EEPROM_ACK_POLL_RETRIES;
+    uint8 status;
+
+    do
+    {
+        /* Send the Start Bit, a previous NACK leaves the bus in repeated start */
+        TWI_start();
+        status = TWI_getStatus();
+        if ((status != TWI_START) && (status != TWI_REP_START))
+            return ERROR;
+
+        /* Send the device address with A8 A9 A10 and R/W=0 (write) */
+        TWI_writeByte((uint8)(0xA0 | ((u16addr & 0x0700)>>7)));
+        if (TWI_getStatus() == TWI_MT_SLA_W_ACK)
+            break;
+    } while (--retries);
+
+    if (retries == 0)
+    {
+        TWI_stop();
+        return ERROR;
+    }
+
+    /* Send the required memory location address */
+    TWI_writeByte((uint8)(u16addr));
+    if (TWI_getStatus() != TWI_MT_DATA_ACK)
+        return ERROR;
+
+    return SUCCESS;
+}
+
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 len)
+{
+    uint8 chunk;
+
+    while (len > 0)
+    {
+        /* Never cross a page boundary, the device would wrap inside the page */
+        chunk = EEPROM_PAGE_SIZE - (uint8)(u16addr & (EEPROM_PAGE_SIZE - 1));
+        if (chunk > len)
+            chunk = (uint8)len;
+
+        if (EEPROM_selectAddress(u16addr) == ERROR)
+            return ERROR;
+
+        u16addr += chunk;
+        len -= chunk;
+        while (chunk--)
+        {
+            TWI_writeByte(*data++);
+            if (TWI_getStatus() != TWI_MT_DATA_ACK)
+                return ERROR;
+        }
+
+        /* Send the Stop Bit, this starts the internal write cycle */
+        TWI_stop();
+    }
+
+    return SUCCESS;
+}
+
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 len)
+{
+    if (len == 0)
+        return SUCCESS;
+
+    if (EEPROM_selectAddress(u16addr) == ERROR)
+        return ERROR;
+
+    /* Send the Repeated Start Bit */
+    TWI_start();
+    if (TWI_getStatus() != TWI_REP_START)
+        return ERROR;
+
+    /* Send the device address with A8 A9 A10 and R/W=1 (Read) */
+    TWI_writeByte((uint8)((0xA0) | ((u16addr & 0x0700)>>7) | 1));
+    if (TWI_getStatus() != TWI_MT_SLA_R_ACK)
+        return ERROR;
+
+    /* ACK every byte but the last, the device keeps incrementing its address */
+    while (--len)
+    {
+        *data++ = TWI_readByteWithACK();
+        if (TWI_getStatus() != TWI_MR_DATA_ACK)
+            return ERROR;
+    }
+
+    *data = TWI_readByteWithNACK();
+    if (TWI_getStatus() != TWI_MR_DATA_NACK)
+        return ERROR;
+
+    /* Send the Stop Bit */
+    TWI_stop();
+
+    return SUCCESS;
+}
@@ -22,11 +22,31 @@
 #define ERROR 0
 #define SUCCESS 1
 
+/* 24C16: 2 KB organised as 16-byte write pages */
+#define EEPROM_PAGE_SIZE        16
+
+/* SLA+W attempts while the device is busy with an internal write cycle (~30us each) */
+#define EEPROM_ACK_POLL_RETRIES 500
+
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
 
 uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
 uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
+
+/*
+ * Description :
+ * Write len bytes starting at u16addr. The data is split at page boundaries and
+ * every page goes out in one transfer. Instead of a fixed delay the device is
+ * polled for ACK, so the function only waits as long as the chip is busy.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 len);
+
+/*
+ * Description :
+ * Read len bytes starting at u16addr with one sequential read.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 len);
  
 #endif /* EXTERNAL_EEPROM_H_ */
@@ -0,0 +1,173 @@
+/******************************************************************************
+ *
+ * Module: Lockout
+ *
+ * File Name: lockout.c
+ *
+ * Description: Source file for the persistent failed-attempt counter and
+ *              exponential backoff lockout
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "lockout.h"
+#include "storage.h"
+#include "config_store.h"
+#include "Buzzer.h"
+#include "tick.h"
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct {
+    uint8 seq;
+    uint8 count;
+} Lockout_SlotType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_failedAttempts = 0;
+static uint8 g_slot = LOCKOUT_SLOTS - 1;   /* Slot holding the current value */
+static uint8 g_seq = LOCKOUT_SEQ_MASK;     /* Its sequence number */
+
+static uint8 g_active = FALSE;
+static Tick_Type g_start;
+static Tick_Type g_duration;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Write the counter into the next slot of the ring */
+static void Lockout_persist(void)
+{
+    Lockout_SlotType slot;
+
+    g_slot = (g_slot + 1) % LOCKOUT_SLOTS;
+    g_seq = (g_seq + 1) & LOCKOUT_SEQ_MASK;
+
+    slot.seq = g_seq;
+    slot.count = g_failedAttempts;
+    Storage_writeRegion(STORAGE_KEY_LOCKOUT, g_slot * sizeof(Lockout_SlotType), &slot, sizeof(Lockout_SlotType));
+}
+
+/* Start a lockout whose length doubles with every failure past the limit */
+static void Lockout_start(void)
+{
+    uint8 shift = g_failedAttempts - Config_get()->maxAttempts;
+    Tick_Type seconds;
+
+    if (shift > LOCKOUT_MAX_SHIFT)
+    {
+        shift = LOCKOUT_MAX_SHIFT;
+    }
+
+    seconds = (Tick_Type)Config_get()->lockoutTime << shift;
+    if (seconds > LOCKOUT_MAX_SECONDS)
+    {
+        seconds = LOCKOUT_MAX_SECONDS;
+    }
+    g_duration = seconds * TICKS_PER_SECOND;
+    g_start = Tick_get();
+    g_active = TRUE;
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, TRUE);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Lockout_init(void)
+{
+    Lockout_SlotType slots[LOCKOUT_SLOTS];
+    uint8 i, next;
+
+    if (Storage_readRegion(STORAGE_KEY_LOCKOUT, 0, slots, sizeof(slots)) == ERROR)
+    {
+        return;
+    }
+
+    /*
+     * The newest slot is the one whose successor does not continue its
+     * sequence. A fully erased page (0xFF) means no failure was ever stored.
+     */
+    for (i = 0; i < LOCKOUT_SLOTS; i++)
+    {
+        next = (i + 1) % LOCKOUT_SLOTS;
+        if ((slots[i].seq != 0xFF) &&
+            ((slots[next].seq == 0xFF) || (slots[next].seq != ((slots[i].seq + 1) & LOCKOUT_SEQ_MASK))))
+        {
+            g_slot = i;
+            g_seq = slots[i].seq;
+            g_failedAttempts = slots[i].count;
+            break;
+        }
+    }
+
+    if (g_failedAttempts >= Config_get()->maxAttempts)
+    {
+        Lockout_start();
+    }
+}
+
+uint8 Lockout_isActive(void)
+{
+    return g_active;
+}
+
+uint8 Lockout_remainingSeconds(void)
+{
+    Tick_Type elapsed;
+
+    if (!g_active)
+    {
+        return 0;
+    }
+
+    elapsed = Tick_get() - g_start;
+    if (elapsed >= g_duration)
+    {
+        return 0;
+    }
+
+    return (uint8)((g_duration - elapsed + TICKS_PER_SECOND - 1) / TICKS_PER_SECOND);
+}
+
+uint8 Lockout_recordFailure(void)
+{
+    if (g_failedAttempts < 0xFF)
+    {
+        g_failedAttempts++;
+    }
+    Lockout_persist();
+
+    if (g_failedAttempts >= Config_get()->maxAttempts)
+    {
+        Lockout_start();
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+void Lockout_recordSuccess(void)
+{
+    if (g_failedAttempts != 0)
+    {
+        g_failedAttempts = 0;
+        Lockout_persist();
+    }
+}
+
+void Lockout_service(void)
+{
+    if (g_active && Tick_hasElapsed(g_start, g_duration))
+    {
+        g_active = FALSE;
+        Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    }
+}
@@ -0,0 +1,84 @@
+/******************************************************************************
+ *
+ * Module: Lockout
+ *
+ * File Name: lockout.h
+ *
+ * Description: Header file for the persistent failed-attempt counter and
+ *              exponential backoff lockout
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef LOCKOUT_H_
+#define LOCKOUT_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Attempts and the first lockout length come from the configuration (config.h) */
+#define LOCKOUT_MAX_SHIFT        6    /* Longest lockout = 64 x the first one */
+
+/*
+ * But never longer than this: the remaining seconds travel as one byte
+ * (Protocol_LockedType, Protocol_StatusType, the audit record)
+ */
+#define LOCKOUT_MAX_SECONDS      255
+
+/*
+ * The counter lives in the internal EEPROM (STORAGE_KEY_LOCKOUT) as a ring of
+ * {sequence, count} slots. Every update goes to the next slot so the write
+ * cycles are spread over the whole ring.
+ */
+#define LOCKOUT_SLOTS            8        /* 2 bytes each, fills STORAGE_LOCKOUT_SIZE */
+#define LOCKOUT_SEQ_MASK         0x7F     /* 0xFF marks an erased slot */
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Restore the counter from EEPROM. Needs Storage_init first. If the limit was already reached before a
+ * reset the lockout starts again, so power cycling does not clear it.
+ * The tick service must be running and Config_init done.
+ */
+void Lockout_init(void);
+
+/*
+ * Description :
+ * Return TRUE while a lockout is running.
+ */
+uint8 Lockout_isActive(void);
+
+/*
+ * Description :
+ * Seconds left in the running lockout (rounded up), 0 if none.
+ */
+uint8 Lockout_remainingSeconds(void);
+
+/*
+ * Description :
+ * Count a wrong password and persist it. Returns TRUE if this failure
+ * started a lockout.
+ */
+uint8 Lockout_recordFailure(void);
+
+/*
+ * Description :
+ * Clear the counter after a correct password. Only writes EEPROM if there
+ * was something to clear.
+ */
+void Lockout_recordSuccess(void);
+
+/*
+ * Description :
+ * Call from the main loop: ends an expired lockout and silences the buzzer.
+ */
+void Lockout_service(void);
+
+#endif /* LOCKOUT_H_ */
@@ -0,0 +1,31 @@
+/******************************************************************************
+ *
+ * Module: Secure Compare
+ *
+ * File Name: secure_compare.h
+ *
+ * Description: Header file for the constant-time byte string comparison used
+ *              on password digests and typed passwords
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef SECURE_COMPARE_H_
+#define SECURE_COMPARE_H_
+
+#include "std_types.h"
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * TRUE if the first length bytes of a and b are equal. The run time depends on
+ * length only, never on where the first mismatch is. Host/tests/compare_timing
+ * checks this by measurement.
+ */
+uint8 SecureCompare_equal(const uint8 *a, const uint8 *b, uint8 length);
+
+#endif /* SECURE_COMPARE_H_ */
@@ -0,0 +1,267 @@
+/******************************************************************************
+ *
+ * Module: Storage
+ *
+ * File Name: storage.c
+ *
+ * Description: Source file for the two-tier key/value store
+ *
+ * Reads from the internal EEPROM take a few cycles per byte, a read over I2C
+ * takes about 25us per byte. Internal writes are slower (8.5ms per byte) and
+ * wear out after 100k cycles, so only small data that is read often lives
+ * there. Every record is followed by a generation byte and a CRC-16 over data
+ * and generation, so a torn or erased copy is never used and the newer of two
+ * valid copies wins.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "storage.h"
+#include "link.h"        /* Write timeouts sized from the records */
+#include <avr/eeprom.h>
+#include <avr/pgmspace.h>  /* The key table lives in flash */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define STORAGE_NONE            0xFFFF  /* No copy on this tier */
+#define STORAGE_TRAILER_SIZE    3       /* Generation, CRC-16 little-endian */
+
+/* The HMI waits for a save as long as these records take to write */
+_Static_assert(STORAGE_CREDENTIAL_SIZE + STORAGE_TRAILER_SIZE == LINK_CREDENTIAL_RECORD,
+        "LINK_CREDENTIAL_RECORD must match the credential record");
+_Static_assert(STORAGE_CONFIG_SIZE + STORAGE_TRAILER_SIZE == LINK_CONFIG_RECORD,
+        "LINK_CONFIG_RECORD must match the configuration record");
+
+#define STORAGE_CRC_POLY        0x1021  /* CRC-16/CCITT */
+
+/* The internal EEPROM is addressed through pointers */
+#define INTERNAL_ADDR(addr)     ((void *)(size_t)(addr))
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef struct {
+    uint16 internalAddr;
+    uint16 externalAddr;
+    uint16 size;
+    uint8  isRecord;
+} Storage_EntryType;
+
+/*******************************************************************************
+ *                           Private Constants                                 *
+ *******************************************************************************/
+
+/*
+ * Internal EEPROM (1 KB): credential at 0x000, lockout ring at 0x020, configuration at 0x040.
+ * External 24C16 (2 KB): credential and configuration mirrors at 0x300 and 0x320,
+ * audit log in the upper 1 KB.
+ */
+static const Storage_EntryType Storage_table[STORAGE_NUM_KEYS] PROGMEM = {
+    [STORAGE_KEY_CREDENTIAL] = { 0x0000,       0x0300,       STORAGE_CREDENTIAL_SIZE, TRUE  },
+    [STORAGE_KEY_CONFIG]     = { 0x0040,       0x0320,       STORAGE_CONFIG_SIZE,     TRUE  },
+    [STORAGE_KEY_LOCKOUT]    = { 0x0020,       STORAGE_NONE, STORAGE_LOCKOUT_SIZE,    FALSE },
+    [STORAGE_KEY_AUDIT_LOG]  = { STORAGE_NONE, 0x0400,       STORAGE_AUDIT_LOG_SIZE,  FALSE },
+};
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Generation of the newest copy of every record */
+static uint8 g_generation[STORAGE_NUM_KEYS];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void Storage_getEntry(Storage_KeyType key, Storage_EntryType *entry)
+{
+    memcpy_P(entry, &Storage_table[key], sizeof(Storage_EntryType));
+}
+
+static uint16 Storage_crcByte(uint16 crc, uint8 byte)
+{
+    uint8 bit;
+
+    crc ^= (uint16)byte << 8;
+    for (bit = 0; bit < 8; bit++)
+    {
+        crc = (crc & 0x8000) ? ((crc << 1) ^ STORAGE_CRC_POLY) : (crc << 1);
+    }
+    return crc;
+}
+
+/* The key seeds the CRC, so a record read from the wrong place does not pass */
+static uint16 Storage_crc(Storage_KeyType key, const uint8 *data, uint16 size, uint8 generation)
+{
+    uint16 crc = 0xFFFF ^ key;
+
+    while (size-- > 0)
+    {
+        crc = Storage_crcByte(crc, *data++);
+    }
+    return Storage_crcByte(crc, generation);
+}
+
+/* TRUE if the trailer after size data bytes matches them */
+static uint8 Storage_isValid(Storage_KeyType key, const uint8 *data, uint16 size, const uint8 *trailer)
+{
+    return (Storage_crc(key, data, size, trailer[0]) == (trailer[1] | ((uint16)trailer[2] << 8)));
+}
+
+static uint8 Storage_readTier(uint16 internalAddr, uint16 externalAddr, void *data, uint16 len)
+{
+    if (internalAddr != STORAGE_NONE)
+    {
+        eeprom_read_block(data, INTERNAL_ADDR(internalAddr), len);
+        return SUCCESS;
+    }
+    return EEPROM_readBlock(externalAddr, (uint8 *)data, len);
+}
+
+static uint8 Storage_writeTier(uint16 internalAddr, uint16 externalAddr, const void *data, uint16 len)
+{
+    if (internalAddr != STORAGE_NONE)
+    {
+        eeprom_update_block(data, INTERNAL_ADDR(internalAddr), len); /* Skips bytes that did not change */
+        return SUCCESS;
+    }
+    return EEPROM_writeBlock(externalAddr, (const uint8 *)data, len);
+}
+
+/* Read one copy of a record, TRUE if it passes its CRC */
+static uint8 Storage_readCopy(Storage_KeyType key, uint16 internalAddr, uint16 externalAddr,
+        uint16 size, uint8 *data, uint8 *generation)
+{
+    if (Storage_readTier(internalAddr, externalAddr, data, size + STORAGE_TRAILER_SIZE) == ERROR)
+    {
+        return FALSE;
+    }
+
+    *generation = data[size];
+    return Storage_isValid(key, data, size, &data[size]);
+}
+
+/* Write one copy of a record with its trailer */
+static uint8 Storage_writeCopy(Storage_KeyType key, uint16 internalAddr, uint16 externalAddr,
+        uint16 size, const uint8 *data, uint8 generation)
+{
+    uint8 trailer[STORAGE_TRAILER_SIZE];
+    uint16 crc = Storage_crc(key, data, size, generation);
+
+    trailer[0] = generation;
+    trailer[1] = (uint8)crc;
+    trailer[2] = (uint8)(crc >> 8);
+
+    if (Storage_writeTier(internalAddr, externalAddr, data, size) == ERROR)
+    {
+        return ERROR;
+    }
+    /* The trailer goes last, a reset in between leaves a copy that fails its CRC */
+    return Storage_writeTier((internalAddr == STORAGE_NONE) ? STORAGE_NONE : internalAddr + size,
+            externalAddr + size, trailer, STORAGE_TRAILER_SIZE);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Storage_init(void)
+{
+    Storage_EntryType entry;
+    uint8 internalCopy[STORAGE_MAX_RECORD_SIZE + STORAGE_TRAILER_SIZE];
+    uint8 externalCopy[STORAGE_MAX_RECORD_SIZE + STORAGE_TRAILER_SIZE];
+    uint8 internalValid, externalValid, internalGen = 0, externalGen = 0;
+    uint8 key;
+
+    for (key = 0; key < STORAGE_NUM_KEYS; key++)
+    {
+        Storage_getEntry(key, &entry);
+        if (!entry.isRecord)
+        {
+            continue;
+        }
+
+        internalValid = Storage_readCopy(key, entry.internalAddr, STORAGE_NONE, entry.size, internalCopy, &internalGen);
+        externalValid = (entry.externalAddr != STORAGE_NONE)
+                && Storage_readCopy(key, STORAGE_NONE, entry.externalAddr, entry.size, externalCopy, &externalGen);
+
+        if (externalValid && (!internalValid || (sint8)(externalGen - internalGen) > 0))
+        {
+            /* First boot with this tier, or a reset hit between the two writes */
+            Storage_writeCopy(key, entry.internalAddr, STORAGE_NONE, entry.size, externalCopy, externalGen);
+            g_generation[key] = externalGen;
+        }
+        else if (internalValid)
+        {
+            if (entry.externalAddr != STORAGE_NONE && (!externalValid || externalGen != internalGen))
+            {
+                Storage_writeCopy(key, STORAGE_NONE, entry.externalAddr, entry.size, internalCopy, internalGen);
+            }
+            g_generation[key] = internalGen;
+        }
+    }
+}
+
+uint8 Storage_read(Storage_KeyType key, void *data)
+{
+    uint16 internalAddr = pgm_read_word(&Storage_table[key].internalAddr);
+    uint16 size = pgm_read_word(&Storage_table[key].size);
+    uint8 trailer[STORAGE_TRAILER_SIZE];
+
+    eeprom_read_block(data, INTERNAL_ADDR(internalAddr), size);
+    eeprom_read_block(trailer, INTERNAL_ADDR(internalAddr + size), STORAGE_TRAILER_SIZE);
+
+    return Storage_isValid(key, data, size, trailer) ? SUCCESS : ERROR;
+}
+
+uint8 Storage_write(Storage_KeyType key, const void *data)
+{
+    Storage_EntryType entry;
+    uint8 status = SUCCESS;
+
+    Storage_getEntry(key, &entry);
+    g_generation[key]++;
+
+    /* External first: if a reset hits before the internal write, Storage_init copies it back */
+    if (entry.externalAddr != STORAGE_NONE
+            && Storage_writeCopy(key, STORAGE_NONE, entry.externalAddr, entry.size, data, g_generation[key]) == ERROR)
+    {
+        status = ERROR;
+    }
+    if (Storage_writeCopy(key, entry.internalAddr, STORAGE_NONE, entry.size, data, g_generation[key]) == ERROR)
+    {
+        status = ERROR;
+    }
+    return status;
+}
+
+uint8 Storage_readRegion(Storage_KeyType key, uint16 offset, void *data, uint16 len)
+{
+    Storage_EntryType entry;
+
+    Storage_getEntry(key, &entry);
+    if (entry.isRecord || (uint32)offset + len > entry.size)
+    {
+        return ERROR;
+    }
+    return Storage_readTier((entry.internalAddr == STORAGE_NONE) ? STORAGE_NONE : entry.internalAddr + offset,
+            entry.externalAddr + offset, data, len);
+}
+
+uint8 Storage_writeRegion(Storage_KeyType key, uint16 offset, const void *data, uint16 len)
+{
+    Storage_EntryType entry;
+
+    Storage_getEntry(key, &entry);
+    if (entry.isRecord || (uint32)offset + len > entry.size)
+    {
+        return ERROR;
+    }
+    return Storage_writeTier((entry.internalAddr == STORAGE_NONE) ? STORAGE_NONE : entry.internalAddr + offset,
+            entry.externalAddr + offset, data, len);
+}
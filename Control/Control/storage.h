@@ -0,0 +1,90 @@
+/******************************************************************************
+ *
+ * Module: Storage
+ *
+ * File Name: storage.h
+ *
+ * Description: Header file for the two-tier key/value store. Hot data lives in
+ *              the ATmega32's own EEPROM, bulk data on the external 24C16.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef STORAGE_H_
+#define STORAGE_H_
+
+#include "std_types.h"
+#include "external_eeprom.h"   /* ERROR / SUCCESS */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Data bytes of the records (the store adds a generation and a CRC-16). The
+ * owners of the structs check them with _Static_assert, so a changed struct
+ * fails the build instead of being read past its end.
+ */
+#define STORAGE_CREDENTIAL_SIZE     25      /* Salt, hash and length, see Control_App.c */
+#define STORAGE_CONFIG_SIZE         9       /* sizeof(Config_Type), see config.h */
+#define STORAGE_MAX_RECORD_SIZE     STORAGE_CREDENTIAL_SIZE
+
+/* Bytes of the regions */
+#define STORAGE_LOCKOUT_SIZE        16
+#define STORAGE_AUDIT_LOG_SIZE      1024
+
+/*******************************************************************************
+ *                         Types Declaration                                   *
+ *******************************************************************************/
+
+typedef enum {
+    /*
+     * Records: read and written whole, checked by a CRC. They are read from
+     * the internal EEPROM and mirrored on the external chip.
+     */
+    STORAGE_KEY_CREDENTIAL,
+    STORAGE_KEY_CONFIG,
+
+    /* Regions: raw bytes at an offset, on one tier only */
+    STORAGE_KEY_LOCKOUT,        /* Internal, failed-attempt ring */
+    STORAGE_KEY_AUDIT_LOG,      /* External, audit event ring */
+
+    STORAGE_NUM_KEYS
+} Storage_KeyType;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Bring the two copies of every record in line after a reset. A copy that is
+ * missing or fails its CRC, or is older than the other one, is rewritten from
+ * the other tier. Needs TWI_init first.
+ */
+void Storage_init(void);
+
+/*
+ * Description :
+ * Read a record from the internal EEPROM. Returns ERROR if it was never
+ * written or fails its CRC; data is undefined then.
+ */
+uint8 Storage_read(Storage_KeyType key, void *data);
+
+/*
+ * Description :
+ * Write a record to both tiers, the external copy first. Returns ERROR if
+ * either write failed.
+ */
+uint8 Storage_write(Storage_KeyType key, const void *data);
+
+/*
+ * Description :
+ * Read or write len bytes of a region starting at offset. Returns ERROR for
+ * a range outside the region or a failed transfer.
+ */
+uint8 Storage_readRegion(Storage_KeyType key, uint16 offset, void *data, uint16 len);
+uint8 Storage_writeRegion(Storage_KeyType key, uint16 offset, const void *data, uint16 len);
+
+#endif /* STORAGE_H_ */
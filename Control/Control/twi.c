@@ -12,11 +12,12 @@
  
 #include "twi.h"
 #include "common_macros.h"
+#include "profile.h"
 #include <avr/io.h>
 
 void TWI_init(const TWI_ConfigType *Config_Ptr) {
     /* Set bit rate register (TWBR) */
-	TWBR =  (uint8)(((F_CPU / (Config_Ptr->bit_rate)) - 16)/2);
+	TWBR = (uint8)Config_Ptr->bit_rate; /* Derived from F_CPU with TWI_BIT_RATE */
 
     /* Clear prescaler bits (TWPS = 00 for prescaler = 1) */
     TWSR = 0x00;
@@ -29,39 +30,49 @@ void TWI_init(const TWI_ConfigType *Config_Ptr) {
 }
 
 void TWI_start(void) {
+    PROFILE_BEGIN(PROFILE_TWI_START);
     /* Clear TWINT, send START condition, enable TWI */
     TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN);
     /* Wait for TWINT flag (start condition transmitted) */
     while (BIT_IS_CLEAR(TWCR, TWINT));
+    PROFILE_END(PROFILE_TWI_START);
 }
 
 void TWI_stop(void) {
+    PROFILE_BEGIN(PROFILE_TWI_STOP);
     /* Clear TWINT, send STOP condition, enable TWI */
     TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+    PROFILE_END(PROFILE_TWI_STOP);
 }
 
 void TWI_writeByte(uint8 data) {
+    PROFILE_BEGIN(PROFILE_TWI_WRITE);
     /* Load data into TWDR */
     TWDR = data;
     /* Clear TWINT, enable TWI */
     TWCR = (1 << TWINT) | (1 << TWEN);
     /* Wait for TWINT flag (data transmitted) */
     while (BIT_IS_CLEAR(TWCR, TWINT));
+    PROFILE_END(PROFILE_TWI_WRITE);
 }
 
 uint8 TWI_readByteWithACK(void) {
+    PROFILE_BEGIN(PROFILE_TWI_READ);
     /* Clear TWINT, enable ACK, enable TWI */
     TWCR = (1 << TWINT) | (1 << TWEA) | (1 << TWEN);
     /* Wait for TWINT flag (data received) */
     while (BIT_IS_CLEAR(TWCR, TWINT));
+    PROFILE_END(PROFILE_TWI_READ);
     return TWDR;
 }
 
 uint8 TWI_readByteWithNACK(void) {
+    PROFILE_BEGIN(PROFILE_TWI_READ);
     /* Clear TWINT, enable TWI (no ACK) */
     TWCR = (1 << TWINT) | (1 << TWEN);
     /* Wait for TWINT flag (data received) */
     while (BIT_IS_CLEAR(TWCR, TWINT));
+    PROFILE_END(PROFILE_TWI_READ);
     return TWDR;
 }
 
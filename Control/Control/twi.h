@@ -14,6 +14,7 @@
 #define TWI_H_
 
 #include "std_types.h"
+#include "cpu_clock.h"
 
 /* I2C Status Bits in TWSR Register */
 #define TWI_START         0x08  /* Start condition transmitted */
@@ -24,6 +25,22 @@
 #define TWI_MR_DATA_ACK   0x50  /* Data received, ACK returned */
 #define TWI_MR_DATA_NACK  0x58  /* Data received, NACK returned */
 
+/* TWBR for an SCL rate with TWPS = 0: SCL = F_CPU / (16 + 2 * TWBR) */
+#define TWI_BIT_RATE(scl_hz)  ((F_CPU / (scl_hz) - 16UL) / 2UL)
+#define TWI_MIN_BIT_RATE      10UL        /* Lowest TWBR the datasheet allows for a master */
+#define TWI_MAX_SCL           400000UL    /* Fast mode, the 24C16 limit */
+
+/* Fastest SCL the device and the TWBR limit allow, also the lowest TWBR a configuration may set */
+#if (F_CPU / TWI_MAX_SCL) > (16UL + 2UL * TWI_MIN_BIT_RATE)
+#define TWI_DEFAULT_BIT_RATE  TWI_BIT_RATE(TWI_MAX_SCL)
+#else
+#define TWI_DEFAULT_BIT_RATE  TWI_MIN_BIT_RATE
+#endif
+
+#if TWI_DEFAULT_BIT_RATE > 255
+#error "F_CPU too fast for 400kHz SCL without the TWI prescaler"
+#endif
+
 /* Custom Types for Configuration */
 typedef uint8  TWI_AddressType;   /* 7-bit slave address */
 typedef uint32 TWI_BaudRateType;  /* Bit rate (TWBR value) */
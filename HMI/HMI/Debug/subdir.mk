@@ -5,34 +5,22 @@
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
 ../HMI_App.c \
-../gpio.c \
-../keypad.c \
-../lcd.c \
-../timer.c \
-../uart.c 
+../keypad.c 
 
 OBJS += \
 ./HMI_App.o \
-./gpio.o \
-./keypad.o \
-./lcd.o \
-./timer.o \
-./uart.o 
+./keypad.o 
 
 C_DEPS += \
 ./HMI_App.d \
-./gpio.d \
-./keypad.d \
-./lcd.d \
-./timer.d \
-./uart.d 
+./keypad.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
 %.o: ../%.c subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
-	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
+	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -I"../../../Common/Common" -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
 	@echo 'Finished building: $<'
 	@echo ' '
 
@@ -6,34 +6,27 @@
 #include "lcd.h"
 #include "keypad.h"
 #include "uart.h"
-#include "timer.h"
 #include "interrupt.h"
-#include <util/delay.h>
-
-/*---- UART Command Definitions ----*/
-typedef enum {
-	CMD_CREATE_PASSWORD = 0x01,
-	CMD_OPEN_DOOR       = 0x03,
-	CMD_CHANGE_PASSWORD = 0x04,
-	CMD_LOCK_SYSTEM     = 0x06,
-	CMD_CHECK_INIT      = 0x07
-} UART_Command;
-
-/*---- UART Response Definitions ----*/
-typedef enum {
-	RESPONSE_OK           = 0xAA,
-	RESPONSE_ERROR        = 0xFF,
-	RESPONSE_PIR_DETECTED = 0x55,
-	RESPONSE_PIR_NOT_DETECTED = 0x66,
-	NEXT_DIGIT = 0xE3,
-} UART_Response;
+#include "tick.h"
+#include "cpu_clock.h"
+#include "profile.h"
+#include "trace.h"
+#include "link.h"
+#include "protocol.h"
+#include "idle.h"
+#include "config.h"
+#include <avr/pgmspace.h> /*---- Screen texts and the screen table stay in flash ----*/
+
+/*---- HMI Only Reply Code, the Rest are in protocol.h ----*/
+#define RESPONSE_LINK_LOST  0x00 /*---- Never sent: no answer, the link was set up again ----*/
 
 /*---- System Constants ----*/
-#define PASSWORD_LENGTH  5
-#define MAX_ATTEMPTS     3
 #define ENTER_KEY        ENTER
-#define LOCKING_TIME     1
-#define LOCKOUT_TIME     3
+
+#define SCREEN_MAX_KEYS  4
+
+/*---- Build Options ----*/
+#define STREAM_DIGITS    1    /*---- 1: send each digit of a password to verify as it is typed ----*/
 
 /*---- System State Definitions ----*/
 typedef enum {
@@ -42,233 +35,450 @@ typedef enum {
 	STATE_OPEN_DOOR,
 	STATE_CHANGE_PASSWORD,
 	STATE_LOCKED,
+#if TRACE_ENABLE
+	STATE_DUMP_TRACE,
+#endif
+#if PROFILE_ENABLE
+	STATE_DUMP_PROFILE,
+#endif
+	NUM_STATES
 } SystemState;
 
+/*---- A Key of a Menu Screen and the State it Leads to ----*/
+typedef struct {
+	uint8 key;
+	uint8 next;
+} KeyBinding;
+
+/*---- Screen of a State: its text, then either a flow or the menu keys ----*/
+typedef struct {
+	const char* line0;          /*---- Flash strings, NULL_PTR: the flow draws the screen ----*/
+	const char* line1;
+	SystemState (*flow)(void);  /*---- Runs the state and returns the next one ----*/
+	uint8 numKeys;              /*---- Menus only: any other key stays on the screen ----*/
+	KeyBinding keys[SCREEN_MAX_KEYS];
+} Screen;
+
 /*---- Global Variables ----*/
 UART_ConfigType uart_config = {
 		.bit_data = UART_8_BIT_DATA,
 		.parity = UART_PARITY_DISABLED,
 		.stop_bit = UART_1_STOP_BIT,
-		.baud_rate = 9600
+		.baud_rate = LINK_BASE_BAUD_RATE /*---- Raised by the negotiation after CMD_CHECK_INIT ----*/
 };
 
-static volatile uint8 time_elapsed = 0;
-uint8 failedAttempts = 0;
 uint8 systemInitialized = 0;
-uint8 password[PASSWORD_LENGTH], confirmPassword[PASSWORD_LENGTH];
-uint8 error;
+uint8 passwords[2 * PASSWORD_MAX_LENGTH]; /*---- Password and its confirmation, sent in one frame ----*/
+uint8 passwordLength = CONFIG_DEFAULT_PASSWORD_LENGTH;    /*---- Digits of the stored password ----*/
+uint8 newPasswordLength = CONFIG_DEFAULT_PASSWORD_LENGTH; /*---- Digits of a password being set ----*/
+uint8 lockoutSeconds; /*---- Lockout length reported by the Control ECU ----*/
 uint8 response;
+uint8 nextSeq = 0;    /*---- Sequence number of the next request ----*/
+Link_FrameType reply;
+uint8 passwordStored; /*---- CMD_CHECK_INIT answer ----*/
+uint8 linkLost = FALSE;
+
+/*---- Request Awaiting its Reply, Kept for Retransmission ----*/
+uint8 requestType, requestSeq, requestLength;
+uint16 requestTimeout;
+const uint8* requestPayload;
+uint8 requestPending = FALSE;
+uint8 heartbeatSeq;
+
+/*---- Sleep while no Request is Outstanding: Bytes Received now are Stale, ----*/
+/*---- such as a Late Heartbeat Reply, and Left Unread would Keep the CPU Awake ----*/
+void HMI_idle(void) {
+	Link_discardPending();
+	Idle_sleep();
+}
+
+/*---- Tick-based Delay Functions, Sleeping between Ticks (Timer1 stays free for profiling) ----*/
+void HMI_delayMs(uint16 ms) {
+	Tick_Type start = Tick_get();
 
-/*---- Timer Callback Function ----*/
-void Timer_CTC_Callback(void) {
-	time_elapsed++;
+	while (!Tick_hasElapsed(start, ms)) {  /*---- Wait for specified time ----*/
+		HMI_idle();
+	}
 }
 
-/*---- Non-blocking Delay Function ----*/
 void HMI_delaySeconds(uint8 seconds) {
-	Timer_ConfigType timerConfig = {
-			.initial_value = 0,
-			.compare_value = 31249,    /*---- 8MHz/256 prescaler = 1 second ----*/
-			.timer_id = TIMER1_ID,
-			.mode = TIMER_MODE_CTC,
-			.prescaler = TIMER_PRESCALER_256
-	};
+	HMI_delayMs(seconds * TICKS_PER_SECOND);
+}
 
-	time_elapsed = 0;
-	Timer_init(&timerConfig);
-	Timer_setCallBack_CTC(Timer_CTC_Callback, TIMER1_ID);
+/*---- Take the Password Lengths from the Control ECU Configuration ----*/
+void fetchConfig(void) {
+	const RESPONSE_CONFIG_PayloadType* config = (const RESPONSE_CONFIG_PayloadType*)reply.payload;
+	uint8 seq = nextSeq++;
+	uint8 stored;
+	Tick_Type sent;
+
+	/*---- Own retry loop: a lost link is already being set up here ----*/
+	for (uint8 tries = 0; tries <= LINK_MAX_RETRIES; tries++) {
+		Link_sendFrame(CMD_GET_CONFIG, seq, NULL_PTR, 0);
+		sent = Tick_get();
+		while (!Tick_hasElapsed(sent, LINK_REQUEST_TIMEOUT)) {
+			if (Link_pollFrame(&reply) == LINK_FRAME_READY && reply.type == RESPONSE_CONFIG && reply.seq == seq
+					&& config->config.version == CONFIG_VERSION) {
+				stored = config->storedLength;
+				if (config->config.passwordLength >= PASSWORD_MIN_LENGTH && config->config.passwordLength <= PASSWORD_MAX_LENGTH) {
+					newPasswordLength = config->config.passwordLength;
+				}
+				if (stored >= PASSWORD_MIN_LENGTH && stored <= PASSWORD_MAX_LENGTH) {
+					passwordLength = stored;
+				}
+				return;
+			}
+			Idle_sleep();
+		}
+	}
+	/*---- No answer: keep the lengths in use ----*/
+}
 
-	while (time_elapsed < seconds); /*---- Wait for specified time ----*/
+/*---- CMD_CHECK_INIT Exchange and Rate Negotiation, at Boot and after a Link Loss ----*/
+void connectControl(void) {
+	UART_setBaudRate(LINK_BASE_BAUD_RATE);
+	while (UART_isByteAvailable()) {
+		UART_recieveByte(); /*---- Leftovers of the old link must not pass for the answer ----*/
+	}
+	do {
+		UART_sendByte(CMD_CHECK_INIT); /*---- Repeated until the Control ECU listens at the base rate ----*/
+	} while (!Link_receiveByte(&passwordStored, LINK_SETUP_TIMEOUT) || passwordStored > TRUE);
+	Link_negotiateMaster();
+	fetchConfig();
+}
 
-	Timer_deInit(TIMER1_ID);       /*---- Cleanup timer ----*/
+/*---- Send a Request without Waiting, Returns its Sequence Number ----*/
+uint8 sendRequest(uint8 command, const uint8* payload, uint8 length) {
+	requestType = command;
+	requestSeq = nextSeq++;
+	requestPayload = payload;
+	requestLength = length;
+	requestPending = TRUE;
+	/*---- A password save answers only once the credential is written ----*/
+	requestTimeout = (command == CMD_CREATE_PASSWORD) ? LINK_WRITE_TIMEOUT(LINK_CREDENTIAL_RECORD) : LINK_REQUEST_TIMEOUT;
+
+	Link_sendFrame(command, requestSeq, payload, length);
+	return requestSeq;
 }
 
-/*---- Send Password with Handshaking ----*/
-void sendPassword(uint8* password) {
-	for (uint8 i = 0; i < PASSWORD_LENGTH; i++) {
-		UART_sendByte(password[i]);
-		while (UART_recieveByte() != NEXT_DIGIT); /*---- Wait for acknowledgment ----*/
+/*---- Wait for the Next Frame of a Request: Retransmit, Send Heartbeats and Resync as Needed ----*/
+void waitFrame(uint8 seq) {
+	Tick_Type sent = Tick_get();  /*---- Last transmission of the request or heartbeat ----*/
+	Tick_Type heard = sent;       /*---- Last frame from the Control ECU ----*/
+	uint8 retries = 0;
+
+	while (1) {
+		if (Link_pollFrame(&reply) == LINK_FRAME_READY) {
+			heard = Tick_get();
+			if (reply.type == RESPONSE_RESYNC) {
+				break;
+			}
+			if (reply.seq == seq) {
+				requestPending = FALSE; /*---- Later frames of this request are events ----*/
+				return;
+			}
+			if (reply.seq != heartbeatSeq) {
+				TRACE(TRACE_UNEXPECTED, seq, reply.seq);
+			}
+			continue;
+		}
+		Idle_sleep(); /*---- Until the next tick or reply byte ----*/
+
+		if (requestPending && requestSeq == seq) {
+			/*---- Reply overdue: resend under the same number ----*/
+			if (!Tick_hasElapsed(sent, requestTimeout)) {
+				continue;
+			}
+			if (retries < LINK_MAX_RETRIES) {
+				retries++;
+				TRACE(TRACE_RETRY, seq, retries);
+				Link_sendFrame(requestType, seq, requestPayload, requestLength);
+				sent = Tick_get();
+				continue;
+			}
+		} else {
+			/*---- Waiting for events: keep checking the Control ECU is there ----*/
+			if (!Tick_hasElapsed(heard, LINK_PEER_TIMEOUT)) {
+				if (Tick_hasElapsed(sent, LINK_HEARTBEAT_PERIOD)) {
+					heartbeatSeq = nextSeq++;
+					Link_sendFrame(CMD_HEARTBEAT, heartbeatSeq, NULL_PTR, 0);
+					sent = Tick_get();
+				}
+				continue;
+			}
+		}
+		break;
 	}
+
+	/*---- The Control ECU is gone or restarted: set the link up again ----*/
+	TRACE(TRACE_RESYNC, seq, 0);
+	connectControl();
+	requestPending = FALSE;
+	linkLost = TRUE;
+	reply.type = RESPONSE_LINK_LOST;
+	reply.seq = seq;
 }
 
-/*---- Get Password from Keypad ----*/
-void getPassword(uint8* buffer) {
+/*---- Clear the LCD and Show One or Two Flash Strings ----*/
+void showScreen(const char* line0, const char* line1) {
+	LCD_clearScreen();
+	LCD_displayString_P(line0);
+	if (line1 != NULL_PTR) {
+		LCD_displayStringRowColumn_P(1, 0, line1);
+	}
+}
+
+/*---- Show a Flash String for a Few Seconds ----*/
+void showMessage(const char* text, uint8 seconds) {
+	showScreen(text, NULL_PTR);
+	HMI_delaySeconds(seconds);
+}
+
+/*---- Get Password from Keypad, Streaming the Digits of one to be Verified ----*/
+void getPassword(uint8* buffer, uint8 length, uint8 stream) {
 	uint8 key, count = 0;
-	while (count < PASSWORD_LENGTH) {
+	while (count < length) {
 		key = KEYPAD_getPressedKey();
 		if (key >= 0 && key <= 9) {
 			buffer[count] = key;
+#if STREAM_DIGITS
+			if (stream) {
+				CMD_DIGIT_PayloadType digit = { count, key };
+				Link_sendFrame(CMD_DIGIT, nextSeq++, (const uint8*)&digit, sizeof(digit)); /*---- Control verifies ahead of ENTER ----*/
+			}
+#endif
 			LCD_moveCursor(1,count);
 			LCD_displayCharacter('*'); /*---- Mask password input ----*/
 			count++;
 		}
-		_delay_ms(350); /*---- Keypad debounce delay ----*/
+		HMI_delayMs(350); /*---- Keypad debounce delay ----*/
 	}
 	while (KEYPAD_getPressedKey() != ENTER_KEY); /*---- Wait for ENTER confirmation ----*/
 }
 
-/*---- Door Unlock Sequence ----*/
-void unlockDoor() {
-	UART_sendByte(CMD_OPEN_DOOR);
-	uint8 response;
-	error = 0;
-	LCD_clearScreen();
-	LCD_displayString("Enter pass: ");
-	getPassword(password);
-	sendPassword(password);
-	response = UART_recieveByte();
-
-	if (response == RESPONSE_OK){
-		/*---- Unlocking procedure ----*/
-		error = 0;
-		LCD_clearScreen();
-		LCD_displayString("UNLOCKING...");
-		HMI_delaySeconds(LOCKING_TIME);
+/*---- Read the Control ECU Verdict on a Request ----*/
+uint8 receiveVerdict(uint8 seq) {
+	waitFrame(seq);
 
-		/*---- Wait for PIR sensor clearance ----*/
-		while (UART_recieveByte() == RESPONSE_PIR_DETECTED){
-			LCD_clearScreen();
-			LCD_displayString("People entering");
-		}
+	if (reply.type == RESPONSE_LOCKED) {
+		lockoutSeconds = ((const RESPONSE_LOCKED_PayloadType*)reply.payload)->seconds;
+	} else if (reply.type != RESPONSE_OK && reply.type != RESPONSE_ERROR && reply.type != RESPONSE_BUSY
+			&& reply.type != RESPONSE_LINK_LOST) {
+		TRACE(TRACE_UNEXPECTED, RESPONSE_OK, reply.type);
+	}
+	return reply.type;
+}
 
-		/*---- Locking procedure ----*/
-		LCD_clearScreen();
-		LCD_displayString("LOCKING...");
-		HMI_delaySeconds(LOCKING_TIME);
-	} else if(response == RESPONSE_ERROR){
-		/*---- Password error handling ----*/
+/*---- Ask the Control ECU for the Remaining Lockout Seconds ----*/
+uint8 queryLockout(void) {
+	waitFrame(sendRequest(CMD_STATUS, NULL_PTR, 0));
+	return (reply.type == RESPONSE_STATUS) ? ((const RESPONSE_STATUS_PayloadType*)reply.payload)->lockoutSeconds : 0;
+}
+
+/*---- Password Creation Flow ----*/
+SystemState createPasswordFlow(void) {
+	getPassword(passwords, newPasswordLength, FALSE);
+
+	showScreen(PSTR("Confirm Password:"), NULL_PTR);
+	getPassword(passwords + newPasswordLength, newPasswordLength, FALSE);
+
+	/*---- Send passwords to Control ECU ----*/
+	response = receiveVerdict(sendRequest(CMD_CREATE_PASSWORD, passwords, 2 * newPasswordLength));
+	if (response == RESPONSE_OK) {
+		passwordLength = newPasswordLength;
+		return STATE_MAIN_OPTIONS;
+	}
+	if (response == RESPONSE_ERROR) {
+		showMessage(PSTR("Mismatch! Retry"), 2);
+	}
+	return STATE_CREATE_PASSWORD;
+}
+
+/*---- Door Unlock Flow ----*/
+SystemState openDoorFlow(void) {
+	uint8 seq;
+
+	getPassword(passwords, passwordLength, TRUE);
+	seq = sendRequest(CMD_OPEN_DOOR, passwords, passwordLength);
+	response = receiveVerdict(seq);
+
+	if (response == RESPONSE_OK) {
+		/*---- Follow the progress events until the door is locked again ----*/
+		do {
+			waitFrame(seq);
+			switch (reply.type) {
+			case EVENT_UNLOCKING:
+				showScreen(PSTR("UNLOCKING..."), NULL_PTR);
+				break;
+			case EVENT_PIR_HOLD:
+				showScreen(PSTR("People entering"), NULL_PTR);
+				break;
+			case EVENT_DOOR_OPEN:
+				showScreen(PSTR("Door open"), NULL_PTR);
+				break;
+			case EVENT_DOOR_HELD:
+				showScreen(PSTR("Close the door!"), NULL_PTR);
+				break;
+			case EVENT_LOCKING:
+				showScreen(PSTR("LOCKING..."), NULL_PTR);
+				break;
+			}
+		} while (reply.type != EVENT_LOCKED && reply.type != RESPONSE_LINK_LOST);
+	} else if (response == RESPONSE_BUSY) {
+		showMessage(PSTR("Door busy"), 1); /*---- Back to the menu, not a failed attempt ----*/
+	} else if (response == RESPONSE_LOCKED) {
+		return STATE_LOCKED;
+	} else if (response == RESPONSE_ERROR) {
+		showMessage(PSTR("wrong pass"), 1);
+		return STATE_OPEN_DOOR; /*---- Retry on failed attempt ----*/
+	}
+	return STATE_MAIN_OPTIONS;
+}
+
+/*---- System Lockout Flow (counted and timed by the Control ECU) ----*/
+SystemState lockedFlow(void) {
+	while (lockoutSeconds > 0) {
 		LCD_clearScreen();
-		LCD_displayString("wrong pass");
+		LCD_displayString_P(PSTR("Locked("));
+		LCD_intgerToString(lockoutSeconds);
+		LCD_displayString_P(PSTR("s)"));
 		HMI_delaySeconds(1);
-		failedAttempts++;
-		error = 1;
+		lockoutSeconds = queryLockout(); /*---- Stays in step with the Control ECU clock ----*/
+	}
+	return STATE_MAIN_OPTIONS;
+}
+
+/*---- Password Change Flow ----*/
+SystemState changePasswordFlow(void) {
+	getPassword(passwords, passwordLength, TRUE);
+	response = receiveVerdict(sendRequest(CMD_CHANGE_PASSWORD, passwords, passwordLength));
+
+	if (response == RESPONSE_OK) {
+		/*---- New password entry ----*/
+		showScreen(PSTR("Enter new pass"), NULL_PTR);
+		getPassword(passwords, newPasswordLength, FALSE);
+
+		showScreen(PSTR("Confirm new pass"), NULL_PTR);
+		getPassword(passwords + newPasswordLength, newPasswordLength, FALSE);
+
+		response = receiveVerdict(sendRequest(CMD_CREATE_PASSWORD, passwords, 2 * newPasswordLength));
+		if (response == RESPONSE_OK) {
+			passwordLength = newPasswordLength;
+			showMessage(PSTR("New pass saved"), 2);
+			return STATE_MAIN_OPTIONS;
+		}
+		if (response == RESPONSE_ERROR) {
+			showMessage(PSTR("No match"), 1);
+		}
+	} else if (response == RESPONSE_ERROR) {
+		showMessage(PSTR("Wrong pass"), 1);
+	} else if (response == RESPONSE_LOCKED) {
+		return STATE_LOCKED;
 	}
+	return STATE_CHANGE_PASSWORD;
 }
 
+#if TRACE_ENABLE
+/*---- Framed as RESPONSE_TRACE, a serial adapter on TXD reads it while the Control ECU ignores it ----*/
+SystemState dumpTraceFlow(void) {
+	Trace_dump(0);
+	return STATE_MAIN_OPTIONS;
+}
+#endif
+
+#if PROFILE_ENABLE
+/*---- Framed as RESPONSE_PROFILE, a serial adapter on TXD reads it while the Control ECU ignores it ----*/
+SystemState dumpProfileFlow(void) {
+	Profile_dump(0);
+	return STATE_MAIN_OPTIONS;
+}
+#endif
+
+/*---- Screen Texts ----*/
+static const char text_enterPassword[] PROGMEM = "Enter Password:";
+static const char text_openDoor[]      PROGMEM = "+ : Open Door";
+static const char text_changePass[]    PROGMEM = "- : Change Pass";
+static const char text_enterPass[]     PROGMEM = "Enter pass: ";
+static const char text_enterOldPass[]  PROGMEM = "Enter old pass";
+
+/*---- Debug keys only exist in the builds that have the dump ----*/
+#define MAIN_MENU_NUM_KEYS  (2 + TRACE_ENABLE + PROFILE_ENABLE)
+
+/*---- Screen Table, Indexed by SystemState ----*/
+static const Screen screens[NUM_STATES] PROGMEM = {
+	[STATE_CREATE_PASSWORD] = { text_enterPassword, NULL_PTR, createPasswordFlow, 0, {{0}} },
+	[STATE_MAIN_OPTIONS]    = { text_openDoor, text_changePass, NULL_PTR, MAIN_MENU_NUM_KEYS, {
+			{ '+', STATE_OPEN_DOOR },
+			{ '-', STATE_CHANGE_PASSWORD },
+#if TRACE_ENABLE
+			{ '%', STATE_DUMP_TRACE },
+#endif
+#if PROFILE_ENABLE
+			{ '=', STATE_DUMP_PROFILE },
+#endif
+	} },
+	[STATE_OPEN_DOOR]       = { text_enterPass, NULL_PTR, openDoorFlow, 0, {{0}} },
+	[STATE_CHANGE_PASSWORD] = { text_enterOldPass, NULL_PTR, changePasswordFlow, 0, {{0}} },
+	[STATE_LOCKED]          = { NULL_PTR, NULL_PTR, lockedFlow, 0, {{0}} },
+#if TRACE_ENABLE
+	[STATE_DUMP_TRACE]      = { NULL_PTR, NULL_PTR, dumpTraceFlow, 0, {{0}} },
+#endif
+#if PROFILE_ENABLE
+	[STATE_DUMP_PROFILE]    = { NULL_PTR, NULL_PTR, dumpProfileFlow, 0, {{0}} },
+#endif
+};
+
 /*---- Main Application Entry Point ----*/
 int main() {
+	Screen screen;
+	uint8 key;
+
+	CPU_CLOCK_CHECK_LIBRARY(); /*---- libCommon.a must be built for this clock ----*/
+
 	/*---- Initialize peripherals ----*/
 	LCD_init();
 	UART_init(&uart_config);
 	Enable_Global_Interrupt();
+	Tick_init();
+	Idle_init();
+	KEYPAD_setIdleCallBack(HMI_idle); /*---- The menus wait for keys with no request outstanding ----*/
+	TRACE(TRACE_BOOT, 0, 0);
+#if PROFILE_ENABLE
+	Profile_init();
+#endif
 
 	/*---- Check if password exists in EEPROM ----*/
-	UART_sendByte(CMD_CHECK_INIT);
-	SystemState currentState = UART_recieveByte() ? STATE_MAIN_OPTIONS : STATE_CREATE_PASSWORD;
+	connectControl();
+	SystemState currentState = passwordStored ? STATE_MAIN_OPTIONS : STATE_CREATE_PASSWORD;
 
 	if(currentState == STATE_MAIN_OPTIONS) {
-		LCD_clearScreen();
-		LCD_displayString("System Ready");
-		HMI_delaySeconds(1);
+		showMessage(PSTR("System Ready"), 1);
 	}
 
-	/*---- Main State Machine ----*/
+	/*---- Main State Machine, driven by the screen table ----*/
 	while (1) {
-		switch (currentState) {
-		/*---- Password Creation State ----*/
-		case STATE_CREATE_PASSWORD:
-			LCD_clearScreen();
-			LCD_displayString("Enter Password:");
-			getPassword(password);
-
-			LCD_clearScreen();
-			LCD_displayString("Confirm Password:");
-			getPassword(confirmPassword);
-
-			/*---- Send passwords to Control ECU ----*/
-			UART_sendByte(CMD_CREATE_PASSWORD);
-			sendPassword(password);
-			sendPassword(confirmPassword);
-
-			if (UART_recieveByte() == RESPONSE_OK) {
-				currentState = STATE_MAIN_OPTIONS;
-			} else {
-				LCD_clearScreen();
-				LCD_displayString("Mismatch! Retry");
-				HMI_delaySeconds(2);
-			}
-			break;
-
-			/*---- Main Menu State ----*/
-		case STATE_MAIN_OPTIONS:
-			LCD_clearScreen();
-			LCD_displayString("+ : Open Door");
-			LCD_displayStringRowColumn(1,0,"- : Change Pass");
-			uint8 key = KEYPAD_getPressedKey();
-			if (key == '+') {
-				currentState = STATE_OPEN_DOOR;
-			} else if (key == '-') {
-				currentState = STATE_CHANGE_PASSWORD;
-			}
-			break;
-
-			/*---- Door Unlock State ----*/
-		case STATE_OPEN_DOOR:
-			unlockDoor();
-			if(error){
-				if(failedAttempts == MAX_ATTEMPTS){
-					currentState = STATE_LOCKED;
-				} else {
-					unlockDoor(); /*---- Retry on failed attempt ----*/
-				}
-			} else {
-				currentState = STATE_MAIN_OPTIONS;
-			}
-			break;
-
-			/*---- System Lockout State ----*/
-		case STATE_LOCKED:
-			UART_sendByte(CMD_LOCK_SYSTEM);
-			LCD_clearScreen();
-			LCD_displayString("Locked(60s)");
-			HMI_delaySeconds(LOCKOUT_TIME);
-			failedAttempts = 0;
-			currentState = STATE_MAIN_OPTIONS;
-			break;
-
-			/*---- Password Change State ----*/
-		case STATE_CHANGE_PASSWORD:
-			UART_sendByte(CMD_CHANGE_PASSWORD);
-			LCD_clearScreen();
-			LCD_displayString("Enter old pass");
-			getPassword(password);
-			sendPassword(password);
-			response = UART_recieveByte();
-
-			if(response == RESPONSE_OK){
-				/*---- New password entry ----*/
-				LCD_clearScreen();
-				LCD_displayString("Enter new pass");
-				getPassword(password);
-
-				LCD_clearScreen();
-				LCD_displayString("Confirm new pass");
-				getPassword(confirmPassword);
-
-				sendPassword(password);
-				sendPassword(confirmPassword);
-				response = UART_recieveByte();
-
-				if(response == RESPONSE_OK){
-					LCD_clearScreen();
-					LCD_displayString("New pass saved");
-					HMI_delaySeconds(2);
-					currentState = STATE_MAIN_OPTIONS;
-				} else if(response == RESPONSE_ERROR){
-					LCD_clearScreen();
-					LCD_displayString("No match");
-					HMI_delaySeconds(1);
-				}
-			} else if(response == RESPONSE_ERROR){
-				failedAttempts++;
-				LCD_clearScreen();
-				LCD_displayString("Wrong pass");
-				HMI_delaySeconds(1);
-				if(failedAttempts == MAX_ATTEMPTS){
-					currentState = STATE_LOCKED;
-				}
+		if (linkLost) {
+			/*---- The flow in progress was cut off, start over from what the Control ECU reports ----*/
+			linkLost = FALSE;
+			showMessage(PSTR("Link restored"), 1);
+			currentState = passwordStored ? STATE_MAIN_OPTIONS : STATE_CREATE_PASSWORD;
+		}
+		TRACE(TRACE_STATE, currentState, 0);
+
+		memcpy_P(&screen, &screens[currentState], sizeof(Screen));
+		if (screen.line0 != NULL_PTR) {
+			showScreen(screen.line0, screen.line1);
+		}
+		if (screen.flow != NULL_PTR) {
+			currentState = screen.flow();
+			continue;
+		}
+
+		key = KEYPAD_getPressedKey();
+		for (uint8 i = 0; i < screen.numKeys; i++) {
+			if (screen.keys[i].key == key) {
+				currentState = screen.keys[i].next;
 			}
-			break;
 		}
 	}
 }
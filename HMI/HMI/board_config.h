@@ -0,0 +1,32 @@
+/******************************************************************************
+ *
+ * Module: Board Configuration
+ *
+ * File Name: board_config.h
+ *
+ * Description: Pin assignment of the HMI_ECU board. The shared drivers in
+ *              Common/Common are board independent; everything wired
+ *              differently per board lives here. The LCD is only fitted on
+ *              this board, its wiring stays in Common/Common/lcd.h.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef BOARD_CONFIG_H_
+#define BOARD_CONFIG_H_
+
+#include "gpio.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Keypad rows and columns, each group on consecutive pins */
+#define KEYPAD_ROW_PORT_ID                PORTB_ID
+#define KEYPAD_FIRST_ROW_PIN_ID           PIN0_ID
+
+#define KEYPAD_COL_PORT_ID                PORTB_ID
+#define KEYPAD_FIRST_COL_PIN_ID           PIN4_ID
+
+#endif /* BOARD_CONFIG_H_ */
@@ -11,7 +11,14 @@
  *******************************************************************************/
 #include "keypad.h"
 #include "gpio.h"
-#include <util/delay.h>
+#include "idle.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Run between scans while no key is pressed */
+static void (*g_idleCallBackPtr)(void) = Idle_sleep;
 
 /*******************************************************************************
  *                      Functions Prototypes(Private)                          *
@@ -35,6 +42,11 @@ static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
  *                      Functions Definitions                                  *
  *******************************************************************************/
 
+void KEYPAD_setIdleCallBack(void (*a_ptr)(void))
+{
+	g_idleCallBackPtr = a_ptr;
+}
+
 uint8 KEYPAD_getPressedKey(void)
 {
 	uint8 col,row;
@@ -75,7 +87,7 @@ uint8 KEYPAD_getPressedKey(void)
 				}
 			}
 			GPIO_setupPinDirection(KEYPAD_ROW_PORT_ID,KEYPAD_FIRST_ROW_PIN_ID+row,PIN_INPUT);
-			_delay_ms(10); /* Add small delay to fix CPU load issue in proteus */
+			(*g_idleCallBackPtr)(); /* Sleep until the next tick instead of spinning, also keeps the CPU load in proteus down */
 		}
 	}	
 }
@@ -14,6 +14,7 @@
 #define KEYPAD_H_
 
 #include "std_types.h"
+#include "board_config.h" /* Keypad port and pins */
 
 /*******************************************************************************
  *                                Definitions                                  *
@@ -23,13 +24,6 @@
 #define KEYPAD_NUM_COLS                   4
 #define KEYPAD_NUM_ROWS                   4
 
-/* Keypad Port Configurations */
-#define KEYPAD_ROW_PORT_ID                PORTB_ID
-#define KEYPAD_FIRST_ROW_PIN_ID           PIN0_ID
-
-#define KEYPAD_COL_PORT_ID                PORTB_ID
-#define KEYPAD_FIRST_COL_PIN_ID           PIN4_ID
-
 /* Keypad button logic configurations */
 #define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
 #define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
@@ -53,4 +47,11 @@
  */
 uint8 KEYPAD_getPressedKey(void);
 
+/*
+ * Description :
+ * Set the function run between keypad scans, Idle_sleep by default. It must
+ * return within a tick or so for the keys to stay responsive.
+ */
+void KEYPAD_setIdleCallBack(void (*a_ptr)(void));
+
 #endif /* KEYPAD_H_ */
@@ -0,0 +1,101 @@
+/******************************************************************************
+ *
+ * Module: Door Contact
+ *
+ * File Name: door_contact_host.c
+ *
+ * Description: Host implementation of DoorContact.h. The host has no external
+ *              interrupts, so an edge is stamped when a poll first sees the
+ *              new level; the door sequence polls on every loop. The poll
+ *              hands the edge over through the pool and queue as INT0 does.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "DoorContact.h"
+#include "gpio.h"
+#include "tick.h"
+#include "pool.h"
+#include "queue.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+QUEUE_DEFINE(DoorContact_Edge, DoorContact_EdgeType *, DOOR_CONTACT_EDGE_BLOCKS)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_lastLevel;
+static Tick_Type g_lastEdge;
+
+POOL_DEFINE(g_edgePool, DoorContact_EdgeType, DOOR_CONTACT_EDGE_BLOCKS);
+static DoorContact_Edge_QueueType g_edges;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint8 DoorContact_poll(void)
+{
+    uint8 level = GPIO_readPin(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID);
+
+    DoorContact_EdgeType *edge;
+
+    if (level != g_lastLevel)
+    {
+        g_lastLevel = level;
+        g_lastEdge = Tick_get();
+
+        edge = Pool_alloc(&g_edgePool);
+        if (edge != NULL_PTR)
+        {
+            edge->time = g_lastEdge;
+            edge->closed = (level == DOOR_CONTACT_CLOSED_LEVEL) ? TRUE : FALSE;
+            DoorContact_Edge_push(&g_edges, edge);
+        }
+    }
+    return level;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void DoorContact_init(void)
+{
+    GPIO_setupPinDirection(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID, PIN_INPUT);
+    GPIO_writePin(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID, LOGIC_HIGH); /* Pull-up */
+
+    g_lastLevel = GPIO_readPin(DOOR_CONTACT_PORT_ID, DOOR_CONTACT_PIN_ID);
+    g_lastEdge = Tick_get();
+    Pool_init(&g_edgePool);
+}
+
+uint8 DoorContact_isClosed(void)
+{
+    return (DoorContact_poll() == DOOR_CONTACT_CLOSED_LEVEL) ? TRUE : FALSE;
+}
+
+uint8 DoorContact_isSettled(uint16 settle_ms)
+{
+    DoorContact_poll();
+    return Tick_hasElapsed(g_lastEdge, settle_ms);
+}
+
+uint8 DoorContact_takeEdge(DoorContact_EdgeType *edge)
+{
+    DoorContact_EdgeType *block;
+
+    DoorContact_poll();
+    if (!DoorContact_Edge_pop(&g_edges, &block))
+    {
+        return FALSE;
+    }
+    *edge = *block;
+    Pool_free(&g_edgePool, block);
+    return TRUE;
+}
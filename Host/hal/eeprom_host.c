@@ -0,0 +1,107 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: eeprom_host.c
+ *
+ * Description: Host implementation of the ATmega32 on-chip EEPROM. Every byte
+ *              that changes costs the 8.5ms write time of the real part. The
+ *              array is saved to the file named by HOST_INTERNAL_EEPROM.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <avr/eeprom.h>
+#include "host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define EEPROM_SIZE             1024
+#define EEPROM_WRITE_US         8500
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8_t g_memory[EEPROM_SIZE];
+static const char *g_file;
+static uint8_t g_loaded = 0;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Load on first use, there is no init call on the target */
+static void EEPROM_load(void)
+{
+    FILE *file;
+
+    if (g_loaded)
+    {
+        return;
+    }
+    g_loaded = 1;
+    memset(g_memory, 0xFF, sizeof(g_memory));   /* Erased device */
+
+    g_file = getenv("HOST_INTERNAL_EEPROM");
+    if (g_file != NULL && (file = fopen(g_file, "rb")) != NULL)
+    {
+        if (fread(g_memory, 1, sizeof(g_memory), file) != sizeof(g_memory))
+        {
+            Host_log("EEPROM: short internal image %s", g_file);
+        }
+        fclose(file);
+    }
+}
+
+static size_t EEPROM_address(const void *p, size_t n)
+{
+    size_t address = (size_t)p;
+
+    if (address + n > EEPROM_SIZE)
+    {
+        Host_log("EEPROM: access 0x%zx+%zu out of range", address, n);
+        exit(1);
+    }
+    return address;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void eeprom_read_block(void *dst, const void *src, size_t n)
+{
+    EEPROM_load();
+    memcpy(dst, &g_memory[EEPROM_address(src, n)], n);
+}
+
+void eeprom_update_block(const void *src, void *dst, size_t n)
+{
+    const uint8_t *bytes = src;
+    size_t address, i;
+    FILE *file;
+
+    EEPROM_load();
+    address = EEPROM_address(dst, n);
+    for (i = 0; i < n; i++)
+    {
+        if (g_memory[address + i] != bytes[i])
+        {
+            g_memory[address + i] = bytes[i];
+            Host_delayUs(EEPROM_WRITE_US);
+        }
+    }
+
+    if (g_file != NULL && (file = fopen(g_file, "wb")) != NULL)
+    {
+        fwrite(g_memory, 1, sizeof(g_memory), file);
+        fclose(file);
+    }
+}
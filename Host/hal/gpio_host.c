@@ -0,0 +1,147 @@
+/******************************************************************************
+ *
+ * Module: GPIO
+ *
+ * File Name: gpio_host.c
+ *
+ * Description: Host implementation of gpio.h. Output pins are logged when they
+ *              change; input pins read the level driven by the scenario, or
+ *              the pull-up when nothing drives them.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "gpio.h"
+#include "host.h"
+#include "common_macros.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_ddr[NUM_OF_PORTS];
+static uint8 g_port[NUM_OF_PORTS];
+static volatile uint8 g_driven[NUM_OF_PORTS];   /* Pins driven from outside */
+static volatile uint8 g_external[NUM_OF_PORTS]; /* Their levels */
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void GPIO_logOutputs(uint8 port_num, uint8 old_value)
+{
+    uint8 changed = (uint8)((old_value ^ g_port[port_num]) & g_ddr[port_num]);
+    uint8 pin;
+
+    for (pin = 0; pin < NUM_OF_PINS_PER_PORT; pin++)
+    {
+        if (BIT_IS_SET(changed, pin))
+        {
+            Host_log("GPIO P%c%u = %u", 'A' + port_num, pin,
+                     BIT_IS_SET(g_port[port_num], pin) ? 1 : 0);
+        }
+    }
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+    if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+    {
+        return;
+    }
+    if (direction == PIN_OUTPUT)
+    {
+        SET_BIT(g_ddr[port_num], pin_num);
+    }
+    else
+    {
+        CLEAR_BIT(g_ddr[port_num], pin_num);
+    }
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+    uint8 old_value;
+
+    if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+    {
+        return;
+    }
+    old_value = g_port[port_num];
+    if (value == LOGIC_HIGH)
+    {
+        SET_BIT(g_port[port_num], pin_num);
+    }
+    else
+    {
+        CLEAR_BIT(g_port[port_num], pin_num);
+    }
+    GPIO_logOutputs(port_num, old_value);
+}
+
+uint8 GPIO_readPin(uint8 port_num, uint8 pin_num)
+{
+    if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+    {
+        return LOGIC_LOW;
+    }
+    return BIT_IS_SET(GPIO_readPort(port_num), pin_num) ? LOGIC_HIGH : LOGIC_LOW;
+}
+
+void GPIO_setupPortDirection(uint8 port_num, GPIO_PortDirectionType direction)
+{
+    if (port_num < NUM_OF_PORTS)
+    {
+        g_ddr[port_num] = (uint8)direction;
+    }
+}
+
+void GPIO_writePort(uint8 port_num, uint8 value)
+{
+    uint8 old_value;
+
+    if (port_num < NUM_OF_PORTS)
+    {
+        old_value = g_port[port_num];
+        g_port[port_num] = value;
+        GPIO_logOutputs(port_num, old_value);
+    }
+}
+
+uint8 GPIO_readPort(uint8 port_num)
+{
+    uint8 inputs;
+
+    if (port_num >= NUM_OF_PORTS)
+    {
+        return 0;
+    }
+
+    /* Outputs read back their latch, undriven inputs read their pull-up */
+    inputs = (uint8)((g_external[port_num] & g_driven[port_num])
+            | (g_port[port_num] & ~g_driven[port_num]));
+    return (uint8)((g_port[port_num] & g_ddr[port_num]) | (inputs & ~g_ddr[port_num]));
+}
+
+void Host_gpioDriveInput(uint8_t port_num, uint8_t pin_num, uint8_t value)
+{
+    if ((pin_num >= NUM_OF_PINS_PER_PORT) || (port_num >= NUM_OF_PORTS))
+    {
+        return;
+    }
+    SET_BIT(g_driven[port_num], pin_num);
+    if (value)
+    {
+        SET_BIT(g_external[port_num], pin_num);
+    }
+    else
+    {
+        CLEAR_BIT(g_external[port_num], pin_num);
+    }
+    Host_log("pin P%c%u driven to %u", 'A' + port_num, pin_num, value ? 1 : 0);
+}
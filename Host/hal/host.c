@@ -0,0 +1,186 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: host.c
+ *
+ * Description: Virtual clock and interrupt delivery of the host build.
+ *
+ * Virtual time is real monotonic time multiplied by HOST_TIME_SCALE, so a
+ * three second lockout passes in 300ms. A SIGALRM every millisecond plays the
+ * role of the interrupt controller: it fires the timer callbacks that became
+ * due, as long as the application enabled interrupts in SREG. Busy-wait loops
+ * on volatile flags therefore behave exactly as on the target.
+ *
+ * A scripted reset re-executes the program with the same file descriptors,
+ * like an MCU reset: RAM is lost, the EEPROM file and the link stay, and the
+ * virtual clock carries on from HOST_BOOT_US.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#define _GNU_SOURCE
+#include "host.h"
+#include <avr/io.h>
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static struct timespec g_start;
+static uint64_t g_timeScale = HOST_DEFAULT_TIME_SCALE;
+static const char *g_name = "ECU";
+static uint64_t g_bootUs;      /* Virtual time of the last reset */
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint64_t Host_realUs(void)
+{
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)(now.tv_sec - g_start.tv_sec) * 1000000ULL
+            + (uint64_t)((now.tv_nsec - g_start.tv_nsec) / 1000);
+}
+
+static void Host_interrupt(int sig)
+{
+    uint64_t now = Host_nowUs();
+    int saved_errno = errno;
+
+    (void)sig;
+    Host_scriptService(now);
+
+    /* Global interrupt enable, bit 7 of SREG */
+    if (SREG & (1 << 7))
+    {
+        Host_timerService(now);
+    }
+    errno = saved_errno;
+}
+
+/* Runs before the application's main() */
+__attribute__((constructor))
+static void Host_init(void)
+{
+    struct sigaction sa;
+    struct itimerval period;
+    const char *env;
+
+    clock_gettime(CLOCK_MONOTONIC, &g_start);
+    setvbuf(stderr, NULL, _IOLBF, 0);
+
+    if ((env = getenv("HOST_NAME")) != NULL)
+    {
+        g_name = env;
+    }
+    if ((env = getenv("HOST_TIME_SCALE")) != NULL && atoi(env) > 0)
+    {
+        g_timeScale = (uint64_t)atoi(env);
+    }
+    if ((env = getenv("HOST_BOOT_US")) != NULL)
+    {
+        g_bootUs = strtoull(env, NULL, 10);
+    }
+    if ((env = getenv("HOST_SCRIPT")) != NULL)
+    {
+        Host_scriptLoad(env);
+    }
+
+    sa.sa_handler = Host_interrupt;
+    sigemptyset(&sa.sa_mask);
+    sa.sa_flags = SA_RESTART;
+    sigaction(SIGALRM, &sa, NULL);
+
+    /* A write to a peer that has exited fails with EPIPE, the UART then ends the run cleanly */
+    signal(SIGPIPE, SIG_IGN);
+
+    /* A reset from the script happens inside the handler, SIGALRM is still blocked */
+    sigemptyset(&sa.sa_mask);
+    sigaddset(&sa.sa_mask, SIGALRM);
+    sigprocmask(SIG_UNBLOCK, &sa.sa_mask, NULL);
+
+    period.it_interval.tv_sec = 0;
+    period.it_interval.tv_usec = HOST_INTERRUPT_PERIOD_US;
+    period.it_value = period.it_interval;
+    setitimer(ITIMER_REAL, &period, NULL);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint64_t Host_nowUs(void)
+{
+    return g_bootUs + Host_realUs() * g_timeScale;
+}
+
+uint64_t Host_bootUs(void)
+{
+    return g_bootUs;
+}
+
+void Host_reset(void)
+{
+    struct itimerval stop = { { 0, 0 }, { 0, 0 } };
+    char boot[24];
+
+    Host_log("reset");
+    setitimer(ITIMER_REAL, &stop, NULL);  /* Would kill the new image before it installs its handler */
+    snprintf(boot, sizeof(boot), "%llu", (unsigned long long)Host_nowUs());
+    setenv("HOST_BOOT_US", boot, 1);
+    execl("/proc/self/exe", g_name, (char *)NULL);
+    perror("reset");
+    _exit(1);
+}
+
+void Host_delayUs(uint64_t us)
+{
+    uint64_t end = Host_nowUs() + us;
+    uint64_t now, real_left;
+    struct timespec ts;
+
+    while ((now = Host_nowUs()) < end)
+    {
+        real_left = (end - now) / g_timeScale + 1;
+        ts.tv_sec = real_left / 1000000ULL;
+        ts.tv_nsec = (long)(real_left % 1000000ULL) * 1000L;
+        nanosleep(&ts, NULL);  /* Cut short by SIGALRM, the loop resumes */
+    }
+}
+
+void Host_pollInterrupts(void)
+{
+    sigset_t alarm, saved;
+
+    /* Keep the SIGALRM handler from firing the same callbacks concurrently */
+    sigemptyset(&alarm);
+    sigaddset(&alarm, SIGALRM);
+    sigprocmask(SIG_BLOCK, &alarm, &saved);
+    Host_interrupt(SIGALRM);
+    sigprocmask(SIG_SETMASK, &saved, NULL);
+}
+
+void Host_log(const char *fmt, ...)
+{
+    va_list args;
+    uint64_t now = Host_nowUs();
+
+    fprintf(stderr, "[%-4s %7llu.%03llums] ", g_name,
+            (unsigned long long)(now / 1000), (unsigned long long)(now % 1000));
+    va_start(args, fmt);
+    vfprintf(stderr, fmt, args);
+    va_end(args);
+    fputc('\n', stderr);
+}
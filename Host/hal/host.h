@@ -0,0 +1,75 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: host.h
+ *
+ * Description: Runtime of the host build: virtual clock, simulated interrupt
+ *              delivery, scripted inputs and logging shared by the host
+ *              implementations of the HAL drivers.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_H_
+#define HOST_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Real time between two simulated interrupt deliveries */
+#define HOST_INTERRUPT_PERIOD_US    1000
+
+/* Virtual time runs this many times faster than real time unless HOST_TIME_SCALE is set */
+#define HOST_DEFAULT_TIME_SCALE     10
+
+#define HOST_MAX_SCRIPT_EVENTS      256
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/* Virtual microseconds since start-up */
+uint64_t Host_nowUs(void);
+
+/* Virtual time of the last reset, 0 at power-up */
+uint64_t Host_bootUs(void);
+
+/* Reset the ECU: run the program again on the same link and EEPROM file */
+void Host_reset(void) __attribute__((noreturn));
+
+/* Block for us virtual microseconds, simulated interrupts keep running */
+void Host_delayUs(uint64_t us);
+
+/*
+ * Deliver due interrupts now instead of at the next SIGALRM. Polling loops
+ * call it so short timeouts measured on the tick stay accurate.
+ */
+void Host_pollInterrupts(void);
+
+/* printf to stderr, prefixed with the ECU name and the virtual time */
+void Host_log(const char *fmt, ...) __attribute__((format(printf, 1, 2)));
+
+/* Fire every simulated timer interrupt that is due (timer_host.c) */
+void Host_timerService(uint64_t now_us);
+
+/* Load the scenario named by HOST_SCRIPT (host_script.c) */
+void Host_scriptLoad(const char *path);
+
+/* Apply due pin events and handle quit (host_script.c) */
+void Host_scriptService(uint64_t now_us);
+
+/*
+ * Wait for the next scripted key press, calling idle until it is due.
+ * Returns 0 once the script has no keys left.
+ */
+uint8_t Host_scriptNextKey(uint8_t *key, void (*idle)(void));
+
+/* Drive an input pin from outside the MCU (gpio_host.c) */
+void Host_gpioDriveInput(uint8_t port_num, uint8_t pin_num, uint8_t value);
+
+#endif /* HOST_H_ */
@@ -0,0 +1,209 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: host_script.c
+ *
+ * Description: Scenario scripts of the host build. One event per line:
+ *
+ *                  <time> key <0-9 | + | - | * | % | = | enter>
+ *                  <time> pin <port><pin> <0 | 1>      e.g. "9000 pin C2 1"
+ *                  <time> reset                        restart the ECU
+ *                  <time> quit
+ *
+ *              <time> is virtual milliseconds since start-up, or "+ms" after
+ *              the previous event. '#' starts a comment.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define KEY_ENTER   13  /* Value KEYPAD_getPressedKey returns for ENTER */
+
+typedef enum {
+    EVENT_KEY,
+    EVENT_PIN,
+    EVENT_RESET,
+    EVENT_QUIT
+} Host_EventKind;
+
+typedef struct {
+    uint64_t time_us;
+    Host_EventKind kind;
+    uint8_t value;          /* Key code or pin level */
+    uint8_t port;
+    uint8_t pin;
+    volatile uint8_t done;
+} Host_EventType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static Host_EventType g_events[HOST_MAX_SCRIPT_EVENTS];
+static uint16_t g_eventsCount;
+static uint16_t g_nextKey;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static int Host_parseKey(const char *name, uint8_t *key)
+{
+    if (name[0] >= '0' && name[0] <= '9' && name[1] == '\0')
+    {
+        *key = (uint8_t)(name[0] - '0');
+    }
+    else if (strcmp(name, "enter") == 0)
+    {
+        *key = KEY_ENTER;
+    }
+    else if (strchr("+-*%=", name[0]) != NULL && name[1] == '\0')
+    {
+        *key = (uint8_t)name[0];
+    }
+    else
+    {
+        return 0;
+    }
+    return 1;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Host_scriptLoad(const char *path)
+{
+    FILE *file = fopen(path, "r");
+    char line[128], verb[16], arg1[16], arg2[16];
+    char *time_str;
+    uint64_t last_us = 0;
+    unsigned line_no = 0;
+    Host_EventType *event;
+    int fields;
+
+    if (file == NULL)
+    {
+        perror(path);
+        exit(1);
+    }
+
+    while (fgets(line, sizeof(line), file) != NULL)
+    {
+        line_no++;
+        line[strcspn(line, "#\r\n")] = '\0';
+        time_str = strtok(line, " \t");
+        if (time_str == NULL)
+        {
+            continue;
+        }
+
+        fields = sscanf(time_str + strlen(time_str) + 1, "%15s %15s %15s", verb, arg1, arg2);
+        event = &g_events[g_eventsCount];
+        event->time_us = (uint64_t)strtoull(time_str + (time_str[0] == '+'), NULL, 10) * 1000ULL;
+        if (time_str[0] == '+')
+        {
+            event->time_us += last_us;
+        }
+        last_us = event->time_us;
+
+        if (g_eventsCount == HOST_MAX_SCRIPT_EVENTS)
+        {
+            fprintf(stderr, "%s:%u: too many events\n", path, line_no);
+            exit(1);
+        }
+        else if (fields == 2 && strcmp(verb, "key") == 0 && Host_parseKey(arg1, &event->value))
+        {
+            event->kind = EVENT_KEY;
+        }
+        else if (fields == 3 && strcmp(verb, "pin") == 0
+                && arg1[0] >= 'A' && arg1[0] <= 'D' && arg1[1] >= '0' && arg1[1] <= '7')
+        {
+            event->kind = EVENT_PIN;
+            event->port = (uint8_t)(arg1[0] - 'A');
+            event->pin = (uint8_t)(arg1[1] - '0');
+            event->value = (uint8_t)(arg2[0] == '1');
+        }
+        else if (fields >= 1 && strcmp(verb, "reset") == 0)
+        {
+            event->kind = EVENT_RESET;
+        }
+        else if (fields >= 1 && strcmp(verb, "quit") == 0)
+        {
+            event->kind = EVENT_QUIT;
+        }
+        else
+        {
+            fprintf(stderr, "%s:%u: bad event\n", path, line_no);
+            exit(1);
+        }
+        g_eventsCount++;
+    }
+    fclose(file);
+}
+
+void Host_scriptService(uint64_t now_us)
+{
+    uint16_t i;
+
+    for (i = 0; i < g_eventsCount; i++)
+    {
+        if (g_events[i].done || g_events[i].kind == EVENT_KEY || g_events[i].time_us > now_us)
+        {
+            continue;
+        }
+        g_events[i].done = 1;
+        if (g_events[i].kind == EVENT_PIN)
+        {
+            /* Pin events from before a reset replay at once: the level outside the MCU stayed */
+            Host_gpioDriveInput(g_events[i].port, g_events[i].pin, g_events[i].value);
+        }
+        else if (g_events[i].kind == EVENT_RESET)
+        {
+            if (g_events[i].time_us > Host_bootUs())
+            {
+                Host_reset();
+            }
+        }
+        else
+        {
+            Host_log("script: quit");
+            _exit(0);
+        }
+    }
+}
+
+uint8_t Host_scriptNextKey(uint8_t *key, void (*idle)(void))
+{
+    uint64_t now;
+
+    while (g_nextKey < g_eventsCount && g_events[g_nextKey].kind != EVENT_KEY)
+    {
+        g_nextKey++;
+    }
+    if (g_nextKey == g_eventsCount)
+    {
+        return 0;
+    }
+
+    /* The key is pressed at its scripted time, or right away if the ECU was busy */
+    while ((now = Host_nowUs()) < g_events[g_nextKey].time_us)
+    {
+        idle();
+    }
+    *key = g_events[g_nextKey].value;
+    g_events[g_nextKey].done = 1;
+    g_nextKey++;
+    return 1;
+}
@@ -0,0 +1,38 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: idle_host.c
+ *
+ * Description: Host implementation of idle.h. Sleeping waits for link data
+ *              or one tick period of virtual time, whichever comes first.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "idle.h"
+#include "uart.h"
+#include "host.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define IDLE_TICK_US    1000
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Idle_init(void)
+{
+}
+
+void Idle_sleep(void)
+{
+    uint64_t end = Host_nowUs() + IDLE_TICK_US;
+
+    /* UART_isByteAvailable already waits a little on every empty poll */
+    while (!UART_isByteAvailable() && Host_nowUs() < end);
+}
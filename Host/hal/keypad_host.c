@@ -0,0 +1,57 @@
+/******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad_host.c
+ *
+ * Description: Host implementation of keypad.h, the presses come from the
+ *              scenario script.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "keypad.h"
+#include "host.h"
+#include "idle.h"
+#include <stdlib.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Run while the next scripted key is not due, as between scans on the board */
+static void (*g_idleCallBackPtr)(void) = Idle_sleep;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void KEYPAD_setIdleCallBack(void (*a_ptr)(void))
+{
+    g_idleCallBackPtr = a_ptr;
+}
+
+uint8 KEYPAD_getPressedKey(void)
+{
+    uint8 key;
+
+    if (!Host_scriptNextKey(&key, g_idleCallBackPtr))
+    {
+        Host_log("keypad: script finished");
+        exit(0);
+    }
+    if (key < 10)
+    {
+        Host_log("keypad: %u", key);
+    }
+    else if (key == ENTER)
+    {
+        Host_log("keypad: enter");
+    }
+    else
+    {
+        Host_log("keypad: %c", key);
+    }
+    return key;
+}
@@ -0,0 +1,150 @@
+/******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd_host.c
+ *
+ * Description: Host implementation of lcd.h. The 2x16 display is a character
+ *              buffer that is logged whenever text is written to it.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "lcd.h"
+#include "host.h"
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define LCD_ROWS        2
+#define LCD_COLUMNS     16
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static char g_screen[LCD_ROWS][LCD_COLUMNS + 1];
+static uint8 g_row;
+static uint8 g_column;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void LCD_logScreen(void)
+{
+    Host_log("LCD |%s|%s|", g_screen[0], g_screen[1]);
+}
+
+static void LCD_putCharacter(uint8 data)
+{
+    /* The controller has 40 columns per row, only the first 16 are visible */
+    if (g_row < LCD_ROWS && g_column < LCD_COLUMNS)
+    {
+        g_screen[g_row][g_column] = (char)data;
+    }
+    g_column++;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void LCD_init(void)
+{
+    LCD_clearScreen();
+}
+
+void LCD_sendCommand(uint8 command)
+{
+    uint8 row;
+
+    if (command == LCD_CLEAR_COMMAND)
+    {
+        for (row = 0; row < LCD_ROWS; row++)
+        {
+            memset(g_screen[row], ' ', LCD_COLUMNS);
+            g_screen[row][LCD_COLUMNS] = '\0';
+        }
+        g_row = 0;
+        g_column = 0;
+    }
+    else if (command == LCD_GO_TO_HOME)
+    {
+        g_row = 0;
+        g_column = 0;
+    }
+    else if (command & LCD_SET_CURSOR_LOCATION)
+    {
+        g_row = (command & 0x40) ? 1 : 0;
+        g_column = command & 0x3F;
+    }
+}
+
+void LCD_displayCharacter(uint8 data)
+{
+    LCD_putCharacter(data);
+    LCD_logScreen();
+}
+
+void LCD_displayString(const char *Str)
+{
+    while (*Str != '\0')
+    {
+        LCD_putCharacter((uint8)*Str++);
+    }
+    LCD_logScreen();
+}
+
+/* Flash and RAM are the same memory on the host */
+void LCD_displayString_P(const char *Str)
+{
+    LCD_displayString(Str);
+}
+
+void LCD_moveCursor(uint8 row, uint8 col)
+{
+    uint8 lcd_memory_address;
+
+    switch (row)
+    {
+    case 0:
+        lcd_memory_address = col;
+        break;
+    case 1:
+        lcd_memory_address = col + 0x40;
+        break;
+    default:
+        lcd_memory_address = col;
+        break;
+    }
+    LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
+}
+
+void LCD_displayStringRowColumn(uint8 row, uint8 col, const char *Str)
+{
+    LCD_moveCursor(row, col);
+    LCD_displayString(Str);
+}
+
+void LCD_displayStringRowColumn_P(uint8 row, uint8 col, const char *Str)
+{
+    LCD_displayStringRowColumn(row, col, Str);
+}
+
+void LCD_intgerToString(int data)
+{
+    char buff[16];
+
+    snprintf(buff, sizeof(buff), "%d", data);
+    LCD_displayString(buff);
+}
+
+void LCD_clearScreen(void)
+{
+    LCD_sendCommand(LCD_CLEAR_COMMAND);
+}
@@ -0,0 +1,22 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: registers_host.c
+ *
+ * Description: Storage for the few AVR registers that application code above
+ *              the HAL reads or writes directly.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <avr/io.h>
+
+volatile uint8_t  SREG;
+volatile uint8_t  DDRA, DDRB, DDRC, DDRD;
+volatile uint8_t  TCCR0, TCNT0, OCR0;
+volatile uint8_t  TCCR1A, TCCR1B;
+volatile uint16_t TCNT1, OCR1A;
+volatile uint8_t  TCCR2, TCNT2, OCR2;
+volatile uint8_t  TIMSK, TIFR;
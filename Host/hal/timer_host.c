@@ -0,0 +1,167 @@
+/******************************************************************************
+ *
+ * Module: Timer
+ *
+ * File Name: timer_host.c
+ *
+ * Description: Host implementation of timer.h. Each timer is a period on the
+ *              virtual clock; its callback fires from the simulated interrupt
+ *              once per elapsed period.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "timer.h"
+#include "cpu_clock.h"
+#include "timer_handlers.h"
+#include "host.h"
+#include <avr/io.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define NUM_OF_TIMERS   3
+
+/* Nanoseconds per CPU cycle at F_CPU */
+#define NS_PER_CYCLE    (1000000000ULL / F_CPU)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const uint16 Timer_prescalerDivisor[] = { 0, 1, 8, 64, 256, 1024 };
+
+static struct {
+    volatile uint8 running;
+    uint64_t start_ns;      /* Virtual time the timer counted from */
+    uint64_t period_ns;     /* One compare match or overflow */
+    uint64_t next_ns;       /* Next callback */
+    uint64_t count_ns;      /* Duration of one count */
+    uint16 top;
+    uint8 isCtc;            /* Compare match rather than overflow */
+    void (*volatile ctc_callback)(void);
+    void (*volatile ovf_callback)(void);
+} g_timers[NUM_OF_TIMERS];
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* Run a handler bound in timer_handlers.h, FALSE if the vector has none */
+static uint8 Timer_runBound(uint8 id, uint8 isCtc)
+{
+#ifdef TIMER0_CTC_HANDLER
+    if (id == TIMER0_ID && isCtc) { TIMER0_CTC_HANDLER(); return TRUE; }
+#endif
+#ifdef TIMER0_OVF_HANDLER
+    if (id == TIMER0_ID && !isCtc) { TIMER0_OVF_HANDLER(); return TRUE; }
+#endif
+#ifdef TIMER1_CTC_HANDLER
+    if (id == TIMER1_ID && isCtc) { TIMER1_CTC_HANDLER(); return TRUE; }
+#endif
+#ifdef TIMER1_OVF_HANDLER
+    if (id == TIMER1_ID && !isCtc) { TIMER1_OVF_HANDLER(); return TRUE; }
+#endif
+#ifdef TIMER2_CTC_HANDLER
+    if (id == TIMER2_ID && isCtc) { TIMER2_CTC_HANDLER(); return TRUE; }
+#endif
+#ifdef TIMER2_OVF_HANDLER
+    if (id == TIMER2_ID && !isCtc) { TIMER2_OVF_HANDLER(); return TRUE; }
+#endif
+    (void)id;
+    (void)isCtc;
+    return FALSE;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void Timer_init(const Timer_ConfigType *config)
+{
+    uint8 id = config->timer_id;
+    uint32 counts;
+    uint64_t now = Host_nowUs() * 1000ULL;
+
+    if (config->prescaler == TIMER_PRESCALER_OFF)
+    {
+        g_timers[id].running = FALSE;
+        return;
+    }
+
+    if (config->mode == TIMER_MODE_CTC)
+    {
+        counts = (uint32)config->compare_value + 1 - config->initial_value;
+        g_timers[id].top = config->compare_value;
+    }
+    else
+    {
+        g_timers[id].top = (id == TIMER1_ID) ? 0xFFFF : 0xFF;
+        counts = (uint32)g_timers[id].top + 1 - config->initial_value;
+    }
+
+    g_timers[id].count_ns = Timer_prescalerDivisor[config->prescaler] * NS_PER_CYCLE;
+    g_timers[id].period_ns = counts * g_timers[id].count_ns;
+    g_timers[id].start_ns = now;
+    g_timers[id].next_ns = now + g_timers[id].period_ns;
+    g_timers[id].isCtc = (config->mode == TIMER_MODE_CTC);
+    g_timers[id].running = TRUE;
+
+    if (id == TIMER1_ID)
+    {
+        TCNT1 = config->initial_value;
+    }
+}
+
+void Timer_deInit(Timer_ID_Type timer_id)
+{
+    uint64_t elapsed;
+
+    if (g_timers[timer_id].running && timer_id == TIMER1_ID)
+    {
+        /* Leave the count in TCNT1 like the stopped hardware counter */
+        elapsed = Host_nowUs() * 1000ULL - g_timers[timer_id].start_ns;
+        TCNT1 = (uint16)(TCNT1 + elapsed / g_timers[timer_id].count_ns);
+    }
+
+    g_timers[timer_id].running = FALSE;
+    g_timers[timer_id].ctc_callback = NULL_PTR;
+    g_timers[timer_id].ovf_callback = NULL_PTR;
+}
+
+void Timer_setCallBack_CTC(void (*callback)(void), Timer_ID_Type timer_id)
+{
+    g_timers[timer_id].ctc_callback = callback;
+}
+
+void Timer_setCallBack_OVF(void (*callback)(void), Timer_ID_Type timer_id)
+{
+    g_timers[timer_id].ovf_callback = callback;
+}
+
+void Host_timerService(uint64_t now_us)
+{
+    uint64_t now = now_us * 1000ULL;
+    uint8 id;
+    void (*callback)(void);
+
+    for (id = 0; id < NUM_OF_TIMERS; id++)
+    {
+        while (g_timers[id].running && g_timers[id].next_ns <= now)
+        {
+            g_timers[id].next_ns += g_timers[id].period_ns;
+            if (Timer_runBound(id, g_timers[id].isCtc))
+            {
+                continue;
+            }
+            callback = g_timers[id].ctc_callback ? g_timers[id].ctc_callback
+                                                 : g_timers[id].ovf_callback;
+            if (callback != NULL_PTR)
+            {
+                callback();
+            }
+        }
+    }
+}
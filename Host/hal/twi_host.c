@@ -0,0 +1,200 @@
+/******************************************************************************
+ *
+ * Module: TWI(I2C)
+ *
+ * File Name: twi_host.c
+ *
+ * Description: Host implementation of twi.h with a 24C16 EEPROM on the bus.
+ *
+ * The model answers at the TWI status code level so external_eeprom.c runs
+ * unchanged: 16-byte page writes wrap inside the page, a write cycle NACKs
+ * the device address for a few polls after STOP, and reads auto-increment.
+ * The array is saved to the file named by HOST_EEPROM after every write.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "twi.h"
+#include "host.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define EEPROM_SIZE             2048
+#define EEPROM_PAGE_SIZE        16
+#define EEPROM_DEVICE_TYPE      0xA0
+
+/* Internal write cycle time (tWR) */
+#define EEPROM_WRITE_CYCLE_US   5000
+
+/* One address poll (START, SLA+W, ACK slot) is about 10 SCL periods at 400kHz */
+#define TWI_POLL_US             25
+
+/* Status codes the application never compares against */
+#define TWI_MT_SLA_W_NACK       0x20
+#define TWI_MR_SLA_R_NACK       0x48
+
+typedef enum {
+    BUS_IDLE,
+    BUS_ADDRESS,        /* START sent, waiting for SLA+R/W */
+    BUS_WORD_ADDRESS,   /* SLA+W acked, next byte is the word address */
+    BUS_WRITE_DATA,
+    BUS_READ_DATA
+} TWI_BusStateType;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_memory[EEPROM_SIZE];
+static const char *g_file;
+static TWI_BusStateType g_state = BUS_IDLE;
+static uint8 g_status;
+static uint8 g_started;         /* A START was already sent in this transfer */
+static uint16 g_address;
+static uint8 g_written;         /* Data bytes written since SLA+W */
+static uint64_t g_busyUntil;   /* End of the running write cycle */
+static uint16 g_busyPolls;     /* Address polls that fit in a write cycle */
+static uint16 g_pollsLeft;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void TWI_saveEeprom(void)
+{
+    FILE *file;
+
+    if (g_file != NULL && (file = fopen(g_file, "wb")) != NULL)
+    {
+        fwrite(g_memory, 1, sizeof(g_memory), file);
+        fclose(file);
+    }
+}
+
+static uint8 TWI_readMemory(void)
+{
+    uint8 data = g_memory[g_address];
+
+    g_address = (g_address + 1) % EEPROM_SIZE;
+    return data;
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+void TWI_init(const TWI_ConfigType *Config_Ptr)
+{
+    FILE *file;
+
+    (void)Config_Ptr;
+
+    /* Polling costs no virtual time here, so the write cycle is also bounded by bus traffic */
+    g_busyPolls = EEPROM_WRITE_CYCLE_US / TWI_POLL_US;
+    memset(g_memory, 0xFF, sizeof(g_memory));   /* Erased device */
+
+    g_file = getenv("HOST_EEPROM");
+    if (g_file != NULL && (file = fopen(g_file, "rb")) != NULL)
+    {
+        if (fread(g_memory, 1, sizeof(g_memory), file) != sizeof(g_memory))
+        {
+            Host_log("TWI: short EEPROM image %s", g_file);
+        }
+        fclose(file);
+    }
+}
+
+void TWI_start(void)
+{
+    g_status = g_started ? TWI_REP_START : TWI_START;
+    g_started = TRUE;
+    g_state = BUS_ADDRESS;
+}
+
+void TWI_stop(void)
+{
+    if (g_state == BUS_WRITE_DATA && g_written > 0)
+    {
+        TWI_saveEeprom();
+        g_busyUntil = Host_nowUs() + EEPROM_WRITE_CYCLE_US;
+        g_pollsLeft = g_busyPolls;
+    }
+    g_started = FALSE;
+    g_state = BUS_IDLE;
+}
+
+void TWI_writeByte(uint8 data)
+{
+    uint16 page;
+
+    switch (g_state)
+    {
+    case BUS_ADDRESS:
+        if ((data & 0xF0) != EEPROM_DEVICE_TYPE
+                || (g_pollsLeft > 0 && Host_nowUs() < g_busyUntil))
+        {
+            if (g_pollsLeft > 0)
+            {
+                g_pollsLeft--;
+            }
+            g_status = (data & 1) ? TWI_MR_SLA_R_NACK : TWI_MT_SLA_W_NACK;
+            g_state = BUS_IDLE;
+        }
+        else if (data & 1)
+        {
+            g_status = TWI_MT_SLA_R_ACK;
+            g_state = BUS_READ_DATA;
+        }
+        else
+        {
+            /* Block select bits A8..A10 come with the device address */
+            g_address = (uint16)((data & 0x0E) << 7);
+            g_status = TWI_MT_SLA_W_ACK;
+            g_state = BUS_WORD_ADDRESS;
+        }
+        break;
+
+    case BUS_WORD_ADDRESS:
+        g_address = (uint16)((g_address & 0x0700) | data);
+        g_written = 0;
+        g_status = TWI_MT_DATA_ACK;
+        g_state = BUS_WRITE_DATA;
+        break;
+
+    case BUS_WRITE_DATA:
+        /* The address counter rolls over inside the page */
+        page = g_address & (uint16)~(EEPROM_PAGE_SIZE - 1);
+        g_memory[g_address] = data;
+        g_address = page | ((g_address + 1) & (EEPROM_PAGE_SIZE - 1));
+        g_written++;
+        g_status = TWI_MT_DATA_ACK;
+        break;
+
+    default:
+        g_status = TWI_MT_SLA_W_NACK;
+        break;
+    }
+}
+
+uint8 TWI_readByteWithACK(void)
+{
+    g_status = TWI_MR_DATA_ACK;
+    return TWI_readMemory();
+}
+
+uint8 TWI_readByteWithNACK(void)
+{
+    g_status = TWI_MR_DATA_NACK;
+    return TWI_readMemory();
+}
+
+uint8 TWI_getStatus(void)
+{
+    return g_status;
+}
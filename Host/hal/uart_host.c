@@ -0,0 +1,160 @@
+/******************************************************************************
+ *
+ * Module: UART
+ *
+ * File Name: uart_host.c
+ *
+ * Description: Host implementation of uart.h. The serial line is a pair of
+ *              file descriptors (HOST_UART_RX_FD / HOST_UART_TX_FD, default
+ *              3 and 4) that run.sh wires to the other ECU through FIFOs.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "uart.h"
+#include "host.h"
+#include "trace.h"
+#include <errno.h>
+#include <poll.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define UART_DEFAULT_RX_FD      3
+#define UART_DEFAULT_TX_FD      4
+
+/* Virtual time spent by one empty poll of the receive flag */
+#define UART_POLL_DELAY_US      100
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_rxFd = UART_DEFAULT_RX_FD;
+static int g_txFd = UART_DEFAULT_TX_FD;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 UART_init(const UART_ConfigType *Config_Ptr)
+{
+    const char *env;
+
+    if ((env = getenv("HOST_UART_RX_FD")) != NULL)
+    {
+        g_rxFd = atoi(env);
+    }
+    if ((env = getenv("HOST_UART_TX_FD")) != NULL)
+    {
+        g_txFd = atoi(env);
+    }
+    return UART_setBaudRate(Config_Ptr->baud_rate);
+}
+
+uint8 UART_setBaudRate(uint32 baud_rate)
+{
+    uint32 divisor, actual, error;
+
+    /* Same acceptance rule as the target, the FIFOs themselves run at any rate */
+    if (baud_rate == 0)
+    {
+        return FALSE;
+    }
+    divisor = ((F_CPU / 8UL) + (baud_rate / 2)) / baud_rate;
+    if ((divisor == 0) || (divisor > 4096))
+    {
+        return FALSE;
+    }
+    actual = F_CPU / (8UL * divisor);
+    error = (actual > baud_rate) ? (actual - baud_rate) : (baud_rate - actual);
+    if ((error * 1000UL) > (baud_rate * UART_MAX_BAUD_ERROR_PERMILLE))
+    {
+        Host_log("UART %lu baud rejected", (unsigned long)baud_rate);
+        return FALSE;
+    }
+    Host_log("UART %lu baud", (unsigned long)baud_rate);
+    return TRUE;
+}
+
+uint8 UART_hadFramingError(void)
+{
+    return FALSE;
+}
+
+void UART_sendByte(const uint8 data)
+{
+    while (write(g_txFd, &data, 1) != 1)
+    {
+        if (errno != EINTR)
+        {
+            Host_log("UART peer closed");
+            exit(0);
+        }
+    }
+#if TRACE_UART_BYTES
+    TRACE(TRACE_UART_TX, data, 0);
+#endif
+}
+
+uint8 UART_recieveByte(void)
+{
+    uint8 data;
+    ssize_t result;
+
+    while ((result = read(g_rxFd, &data, 1)) != 1)
+    {
+        if (result == 0 || errno != EINTR)
+        {
+            Host_log("UART peer closed");
+            exit(0);
+        }
+    }
+#if TRACE_UART_BYTES
+    TRACE(TRACE_UART_RX, data, 0);
+#endif
+    return data;
+}
+
+uint8 UART_isByteAvailable(void)
+{
+    struct pollfd pfd = { .fd = g_rxFd, .events = POLLIN };
+
+    Host_pollInterrupts();
+
+    /* A hung-up peer reads as available so the next receive sees the EOF */
+    if (poll(&pfd, 1, 0) > 0 && (pfd.revents & (POLLIN | POLLHUP)))
+    {
+        return TRUE;
+    }
+    Host_delayUs(UART_POLL_DELAY_US);
+    return FALSE;
+}
+
+void UART_sendString(const uint8 *Str)
+{
+    uint8 i = 0;
+
+    while (Str[i] != '\0')
+    {
+        UART_sendByte(Str[i]);
+        i++;
+    }
+}
+
+void UART_receiveString(uint8 *Str)
+{
+    uint8 i = 0;
+
+    Str[i] = UART_recieveByte();
+    while (Str[i] != '#')
+    {
+        i++;
+        Str[i] = UART_recieveByte();
+    }
+    Str[i] = '\0';
+}
@@ -0,0 +1,22 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: eeprom.h
+ *
+ * Description: Host stand-in for <avr/eeprom.h>, the on-chip EEPROM is an
+ *              array kept in a file (hal/eeprom_host.c)
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_EEPROM_H_
+#define HOST_AVR_EEPROM_H_
+
+#include <stddef.h>
+
+void eeprom_read_block(void *dst, const void *src, size_t n);
+void eeprom_update_block(const void *src, void *dst, size_t n);
+
+#endif /* HOST_AVR_EEPROM_H_ */
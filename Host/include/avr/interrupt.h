@@ -0,0 +1,22 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: interrupt.h
+ *
+ * Description: Host stand-in for <avr/interrupt.h>. Simulated interrupts are
+ *              delivered from a signal handler that checks the I bit of SREG.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define sei()   (SREG |= (1 << 7))
+#define cli()   (SREG &= ~(1 << 7))
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
@@ -0,0 +1,54 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: io.h
+ *
+ * Description: Host stand-in for <avr/io.h>. The registers that code above the
+ *              HAL touches directly are plain variables (registers_host.c).
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+extern volatile uint8_t  SREG;
+extern volatile uint8_t  DDRA, DDRB, DDRC, DDRD;
+extern volatile uint8_t  TCCR0, TCNT0, OCR0;
+extern volatile uint8_t  TCCR1A, TCCR1B;
+extern volatile uint16_t TCNT1, OCR1A;
+extern volatile uint8_t  TCCR2, TCNT2, OCR2;
+extern volatile uint8_t  TIMSK, TIFR;
+
+/* Timer0 */
+#define CS00    0
+#define CS01    1
+#define CS02    2
+#define WGM01   3
+#define COM00   4
+#define COM01   5
+#define WGM00   6
+#define FOC0    7
+
+/* Timer1 */
+#define CS10    0
+#define CS11    1
+#define CS12    2
+#define WGM12   3
+
+/* TIMSK / TIFR */
+#define TOIE0   0
+#define OCIE0   1
+#define TOIE1   2
+#define TOV1    2
+#define OCIE1A  4
+#define TOIE2   6
+#define OCIE2   7
+
+#define PB3     3
+
+#endif /* HOST_AVR_IO_H_ */
@@ -0,0 +1,26 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: pgmspace.h
+ *
+ * Description: Host stand-in for <avr/pgmspace.h>, flash data is ordinary memory
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(s)                         (s)
+#define pgm_read_byte(addr)             (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)             (*(const uint16_t *)(addr))
+#define pgm_read_dword(addr)            (*(const uint32_t *)(addr))
+#define memcpy_P(dest, src, n)          memcpy((dest), (src), (n))
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,21 @@
+/******************************************************************************
+ *
+ * Module: Host Simulation
+ *
+ * File Name: delay.h
+ *
+ * Description: Host stand-in for <util/delay.h>, delays run on the virtual clock
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+#include "host.h"
+
+#define _delay_ms(ms)   Host_delayUs((uint64_t)((ms) * 1000.0))
+#define _delay_us(us)   Host_delayUs((uint64_t)(us))
+
+#endif /* HOST_UTIL_DELAY_H_ */
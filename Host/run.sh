@@ -0,0 +1,132 @@
+#!/bin/sh
+################################################################################
+# Run both host ECUs against one scenario, wired to each other through FIFOs.
+#
+#   ./run.sh <scenario> [eeprom image]
+#
+# scenarios/<scenario>.hmi drives the keypad, scenarios/<scenario>.ctrl drives
+# the Control ECU inputs (PIR, door contact on D2). The EEPROM images start erased unless an
+# existing file is given, the on-chip EEPROM is kept next to it as <image>.int. HOST_TIME_SCALE speeds up virtual time (default 10).
+#
+# scenarios/<scenario>.expect, when present, lists what the run must produce;
+# the script exits non-zero if a line is missing or either ECU failed. Each
+# line is one of:
+#
+#   HMI <text>                 a log line of that ECU containing <text>, after
+#   CTRL <text>                the one matched by the previous line of the ECU
+#   eeprom int|ext <offset> <hex bytes...>
+#                              bytes of the on-chip or 24C16 image at the end
+#   audit <hex events...>      the event byte of every audit record, oldest first
+#
+# The expectations assume erased EEPROMs, they are skipped for an existing image.
+################################################################################
+
+set -e
+
+cd "$(dirname "$0")"
+SCENARIO=scenarios/$1
+[ -n "$1" ] && [ -f "$SCENARIO.hmi" ] || { echo "usage: $0 <scenario> [eeprom image]" >&2; exit 2; }
+
+make -s all
+
+LINK=$(mktemp -d)
+trap 'rm -rf "$LINK"' EXIT
+mkfifo "$LINK/hmi_to_control" "$LINK/control_to_hmi"
+
+EEPROM=${2:-$LINK/eeprom.bin}
+CTRL_SCRIPT=$SCENARIO.ctrl
+[ -f "$CTRL_SCRIPT" ] || CTRL_SCRIPT=/dev/null
+
+EXPECT=$SCENARIO.expect
+if [ -f "$EEPROM" ] && [ -f "$EXPECT" ]; then
+    echo "$EEPROM exists, not checking $EXPECT" >&2
+    EXPECT=/dev/null
+fi
+[ -f "$EXPECT" ] || EXPECT=/dev/null
+
+run_ecus()
+{
+    # Control opens its receive end first, the HMI opens the FIFOs in the same order
+    HOST_NAME=CTRL HOST_SCRIPT=$CTRL_SCRIPT HOST_EEPROM=$EEPROM HOST_INTERNAL_EEPROM=$EEPROM.int \
+        build/control_ecu 3<"$LINK/hmi_to_control" 4>"$LINK/control_to_hmi" &
+    CONTROL_PID=$!
+
+    HMI_STATUS=0
+    HOST_NAME=HMI HOST_SCRIPT=$SCENARIO.hmi \
+        build/hmi_ecu 4>"$LINK/hmi_to_control" 3<"$LINK/control_to_hmi" || HMI_STATUS=$?
+
+    CONTROL_STATUS=0
+    wait $CONTROL_PID || CONTROL_STATUS=$?
+    echo "$HMI_STATUS $CONTROL_STATUS" >"$LINK/status"
+}
+
+# Bytes of an image as lower-case hex, one per line
+image_bytes()
+{
+    od -An -v -tx1 -j "$2" ${3:+-N "$3"} "$1" | tr -s ' ' '\n' | grep .
+}
+
+run_ecus 2>&1 | tee "$LINK/log"
+read HMI_STATUS CONTROL_STATUS <"$LINK/status"
+
+FAILED=0
+[ "$HMI_STATUS" -eq 0 ] || { echo "FAIL: hmi_ecu exited with $HMI_STATUS"; FAILED=1; }
+[ "$CONTROL_STATUS" -eq 0 ] || { echo "FAIL: control_ecu exited with $CONTROL_STATUS"; FAILED=1; }
+
+# Log lines, in order per ECU
+awk -v logfile="$LINK/log" '
+    BEGIN {
+        while ((getline line < logfile) > 0) {
+            if (match(line, /^\[[A-Z]+ /)) {
+                ecu = substr(line, 2, RLENGTH - 2)
+                text[ecu, ++count[ecu]] = substr(line, index(line, "]") + 2)
+            }
+        }
+    }
+    $1 == "HMI" || $1 == "CTRL" {
+        want = $0
+        sub(/^[A-Z]+[ \t]+/, "", want)
+        start = pos[$1]
+        found = 0
+        while (!found && pos[$1] < count[$1]) {
+            found = index(text[$1, ++pos[$1]], want)
+        }
+        if (!found) {
+            print "FAIL: " $1 " never showed \"" want "\" (" FILENAME ":" FNR ")"
+            pos[$1] = start   # Keep checking the rest from the last match
+            failed = 1
+        }
+    }
+    END { exit failed }
+' "$EXPECT" || FAILED=1
+
+# EEPROM contents
+while read -r KIND ARG1 ARG2 REST; do
+    case $KIND in
+    eeprom)
+        IMAGE=$EEPROM
+        [ "$ARG1" = int ] && IMAGE=$EEPROM.int
+        WHAT="$ARG1 EEPROM at $ARG2"
+        WANT=$(echo $REST)
+        GOT=$(image_bytes "$IMAGE" $((ARG2)) $(echo $REST | wc -w) | tr '\n' ' ' | sed 's/ $//')
+        ;;
+    audit)
+        # Records are 8 bytes, the event is the fifth; the ring of a fresh image starts at its base
+        WHAT="audit events"
+        WANT=$(echo $ARG1 $ARG2 $REST)
+        GOT=$(image_bytes "$EEPROM" 1024 1024 | awk 'NR % 8 == 5 { if ($0 == "ff") exit; print }' | tr '\n' ' ' | sed 's/ $//')
+        ;;
+    *)
+        continue
+        ;;
+    esac
+    if [ "$GOT" != "$WANT" ]; then
+        echo "FAIL: $WHAT: expected \"$WANT\", got \"$GOT\""
+        FAILED=1
+    fi
+done <"$EXPECT"
+
+if [ "$EXPECT" != /dev/null ]; then
+    [ $FAILED -eq 0 ] && echo "PASS: $1" || echo "FAIL: $1"
+fi
+exit $FAILED
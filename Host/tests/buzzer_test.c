@@ -0,0 +1,120 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: buzzer_test.c
+ *
+ * Description: Unit tests for the buzzer owners (Control/Control/Buzzer.c):
+ *              the lockout and the held-open alarm overlapping in either
+ *              order, and repeated requests from one owner.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "Buzzer.h"
+#include "gpio.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #condition);        \
+            g_failures++;                                                       \
+        }                                                                       \
+    } while (0)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_failures = 0;
+static uint8 g_level = 0xFF;    /* Last level written to the buzzer pin */
+
+/*******************************************************************************
+ *                                  Stubs                                      *
+ *******************************************************************************/
+
+void GPIO_setupPinDirection(uint8 port_num, uint8 pin_num, GPIO_PinDirectionType direction)
+{
+    (void)port_num;
+    (void)pin_num;
+    (void)direction;
+}
+
+void GPIO_writePin(uint8 port_num, uint8 pin_num, uint8 value)
+{
+    if (port_num == BUZZER_PORT_ID && pin_num == BUZZER_PIN_ID)
+    {
+        g_level = value;
+    }
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void testOverlap(void)
+{
+    Buzzer_init();
+    CHECK(g_level == LOGIC_LOW);
+
+    /* Lockout ends while the door is held open: the door alarm keeps sounding */
+    Buzzer_request(BUZZER_OWNER_DOOR, TRUE);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, TRUE);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    CHECK(g_level == LOGIC_HIGH);
+    Buzzer_request(BUZZER_OWNER_DOOR, FALSE);
+    CHECK(g_level == LOGIC_LOW);
+
+    /* The door shuts during a lockout: the lockout keeps sounding */
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, TRUE);
+    Buzzer_request(BUZZER_OWNER_DOOR, TRUE);
+    Buzzer_request(BUZZER_OWNER_DOOR, FALSE);
+    CHECK(g_level == LOGIC_HIGH);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    CHECK(g_level == LOGIC_LOW);
+}
+
+static void testRepeatedRequests(void)
+{
+    Buzzer_init();
+
+    /* A mask, not a count: one release undoes any number of requests */
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, TRUE);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, TRUE);
+    CHECK(g_level == LOGIC_HIGH);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    CHECK(g_level == LOGIC_LOW);
+
+    /* Releasing an owner that never asked changes nothing */
+    Buzzer_request(BUZZER_OWNER_DOOR, FALSE);
+    CHECK(g_level == LOGIC_LOW);
+    Buzzer_request(BUZZER_OWNER_DOOR, TRUE);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    CHECK(g_level == LOGIC_HIGH);
+
+    /* A reset silences every owner */
+    Buzzer_init();
+    CHECK(g_level == LOGIC_LOW);
+    Buzzer_request(BUZZER_OWNER_LOCKOUT, FALSE);
+    CHECK(g_level == LOGIC_LOW);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    testOverlap();
+    testRepeatedRequests();
+
+    printf("buzzer: %s\n", g_failures ? "FAIL" : "ok");
+    return g_failures ? 1 : 0;
+}
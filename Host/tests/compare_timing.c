@@ -0,0 +1,207 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: compare_timing.c
+ *
+ * Description: Timing test for SecureCompare_equal. The run time of a compare
+ *              must not depend on how many leading bytes match, or the
+ *              password can be guessed one byte at a time.
+ *
+ * For every matching prefix length from 0 to the whole string, the test times
+ * batches of compares. The classes are visited in a new random order every
+ * round so drift in the clock speed spreads over all of them, and the median
+ * of the rounds is kept per class. The test fails when the medians correlate
+ * with the prefix length.
+ *
+ * An early-exit compare is measured the same way first. It leaks on purpose,
+ * and if the test does not catch it the machine is too noisy to trust a pass,
+ * so that fails as well.
+ *
+ * The host compiler is not avr-gcc: a pass here shows the C has no
+ * data-dependent branch, the AVR listing is still worth a look after a
+ * compiler upgrade.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "secure_compare.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <math.h>
+#include <time.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Longer than the 16-byte digest so a per-byte leak stands well above the noise */
+#define COMPARE_LENGTH          64
+#define CLASS_COUNT             (COMPARE_LENGTH + 1)    /* 0..COMPARE_LENGTH bytes matching */
+#define ROUNDS                  201
+#define BATCH                   200                     /* Compares per timed sample */
+
+/* Pearson coefficient above which the time is taken to follow the prefix. Noise
+ * alone stays within about +-0.3 over 65 classes. */
+#define CORRELATION_LIMIT       0.5
+
+typedef uint8 (*CompareFunction)(const uint8 *a, const uint8 *b, uint8 length);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static uint8 g_secret[COMPARE_LENGTH];
+static uint8 g_guesses[CLASS_COUNT][COMPARE_LENGTH];
+static double g_samples[CLASS_COUNT][ROUNDS];
+
+/* Read through volatile so the calls are neither inlined nor hoisted out of the batch */
+static volatile uint8 g_sink;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+/* The reference leak: returns at the first differing byte */
+static uint8 earlyExitCompare(const uint8 *a, const uint8 *b, uint8 length)
+{
+    uint8 i;
+
+    for (i = 0; i < length; i++)
+    {
+        if (a[i] != b[i])
+        {
+            return FALSE;
+        }
+    }
+    return TRUE;
+}
+
+static double nowNs(void)
+{
+    struct timespec ts;
+
+    clock_gettime(CLOCK_MONOTONIC, &ts);
+    return ts.tv_sec * 1e9 + ts.tv_nsec;
+}
+
+static int compareDoubles(const void *a, const void *b)
+{
+    double x = *(const double *)a;
+    double y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static void shuffle(uint8 *order, int count)
+{
+    int i, j;
+    uint8 swap;
+
+    for (i = count - 1; i > 0; i--)
+    {
+        j = rand() % (i + 1);
+        swap = order[i];
+        order[i] = order[j];
+        order[j] = swap;
+    }
+}
+
+/* Correlation of the median time per class with the number of matching bytes */
+static double measure(CompareFunction volatile compare, double *span)
+{
+    uint8 order[CLASS_COUNT];
+    double medians[CLASS_COUNT];
+    double meanX = 0, meanY = 0, sxx = 0, syy = 0, sxy = 0, start;
+    int round, i, n;
+
+    for (i = 0; i < CLASS_COUNT; i++)
+    {
+        order[i] = (uint8)i;
+    }
+
+    for (round = 0; round < ROUNDS; round++)
+    {
+        shuffle(order, CLASS_COUNT);
+        for (i = 0; i < CLASS_COUNT; i++)
+        {
+            const uint8 *guess = g_guesses[order[i]];
+
+            start = nowNs();
+            for (n = 0; n < BATCH; n++)
+            {
+                g_sink = compare(g_secret, guess, COMPARE_LENGTH);
+            }
+            g_samples[order[i]][round] = nowNs() - start;
+        }
+    }
+
+    for (i = 0; i < CLASS_COUNT; i++)
+    {
+        qsort(g_samples[i], ROUNDS, sizeof(double), compareDoubles);
+        medians[i] = g_samples[i][ROUNDS / 2] / BATCH;
+        meanX += i;
+        meanY += medians[i];
+    }
+    meanX /= CLASS_COUNT;
+    meanY /= CLASS_COUNT;
+
+    for (i = 0; i < CLASS_COUNT; i++)
+    {
+        sxx += (i - meanX) * (i - meanX);
+        syy += (medians[i] - meanY) * (medians[i] - meanY);
+        sxy += (i - meanX) * (medians[i] - meanY);
+    }
+
+    *span = medians[CLASS_COUNT - 1] - medians[0];
+    return (syy > 0) ? sxy / sqrt(sxx * syy) : 0;
+}
+
+static uint8 check(const char *name, CompareFunction compare, uint8 shouldLeak)
+{
+    double span;
+    double r = measure(compare, &span);
+    uint8 leaks = (r > CORRELATION_LIMIT);
+
+    printf("%-20s r = %+.3f, %+.2f ns from 0 to %d matching bytes: %s\n", name, r, span,
+           COMPARE_LENGTH, leaks ? "leaks" : "constant");
+    return (leaks == shouldLeak);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    int i, j;
+    uint8 ok = TRUE;
+
+    srand((unsigned)time(NULL));
+    for (j = 0; j < COMPARE_LENGTH; j++)
+    {
+        g_secret[j] = (uint8)rand();
+    }
+
+    /* Guess i matches the first i bytes and differs in every byte after them */
+    for (i = 0; i < CLASS_COUNT; i++)
+    {
+        for (j = 0; j < COMPARE_LENGTH; j++)
+        {
+            g_guesses[i][j] = (j < i) ? g_secret[j] : (uint8)~g_secret[j];
+        }
+    }
+
+    if (!check("early exit (control)", earlyExitCompare, TRUE))
+    {
+        printf("FAIL: the reference leak was not detected, timing too noisy to judge\n");
+        return 1;
+    }
+    if (!check("SecureCompare_equal", SecureCompare_equal, FALSE))
+    {
+        ok = FALSE;
+        printf("FAIL: SecureCompare_equal time follows the matching prefix\n");
+    }
+    return ok ? 0 : 1;
+}
@@ -0,0 +1,165 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: event_test.c
+ *
+ * Description: Unit tests for the event flag group (Common/Common/event.h):
+ *              take clears only the flags in its mask, a flag raised after a
+ *              take stays pending, the interrupt flag is restored, and wait
+ *              sleeps until an ISR raises a flag it waits for.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "event.h"
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #condition);        \
+            g_failures++;                                                       \
+        }                                                                       \
+    } while (0)
+
+#define SREG_I          (1 << 7)
+
+#define EVENT_RX        (1 << 0)
+#define EVENT_TICK      (1 << 1)
+#define EVENT_DOOR      (1 << 7)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_failures = 0;
+
+/* The "ISR" Idle_sleep runs on its wake-up number g_isrAt */
+static Event_GroupType *g_isrGroup;
+static uint8 g_isrFlags;
+static int g_isrAt;
+static int g_sleeps;
+
+/*******************************************************************************
+ *                                  Stubs                                      *
+ *******************************************************************************/
+
+/* Stands in for idle.c: each call is one wake-up, an interrupt may run on it */
+void Idle_sleep(void)
+{
+    g_sleeps++;
+    if (g_sleeps == g_isrAt)
+    {
+        Event_setFromIsr(g_isrGroup, g_isrFlags);
+    }
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void testTakeClearsOnlyMask(void)
+{
+    Event_GroupType group = 0;
+
+    CHECK(Event_take(&group, 0xFF) == 0);
+
+    Event_setFromIsr(&group, EVENT_RX | EVENT_DOOR);
+    Event_set(&group, EVENT_TICK);
+    CHECK(group == (EVENT_RX | EVENT_TICK | EVENT_DOOR));
+
+    /* Only the flags asked for are returned and cleared */
+    CHECK(Event_take(&group, EVENT_RX | EVENT_TICK) == (EVENT_RX | EVENT_TICK));
+    CHECK(group == EVENT_DOOR);
+    CHECK(Event_take(&group, EVENT_RX) == 0);
+    CHECK(group == EVENT_DOOR);
+
+    /* Raised after a take: pending for the next one, not lost */
+    Event_setFromIsr(&group, EVENT_RX);
+    CHECK(Event_take(&group, 0xFF) == (EVENT_RX | EVENT_DOOR));
+    CHECK(group == 0);
+
+    /* Raising a pending flag again does not count it twice */
+    Event_setFromIsr(&group, EVENT_TICK);
+    Event_setFromIsr(&group, EVENT_TICK);
+    CHECK(Event_take(&group, EVENT_TICK) == EVENT_TICK);
+    CHECK(Event_take(&group, EVENT_TICK) == 0);
+}
+
+static void testInterruptFlagRestored(void)
+{
+    Event_GroupType group = 0;
+
+    /* Set and take put the I bit back as they found it, on or off */
+    SREG = SREG_I;
+    Event_set(&group, EVENT_RX);
+    CHECK(SREG == SREG_I);
+    CHECK(Event_take(&group, EVENT_RX) == EVENT_RX);
+    CHECK(SREG == SREG_I);
+
+    SREG = 0;
+    Event_set(&group, EVENT_RX);
+    CHECK(SREG == 0);
+    CHECK(Event_take(&group, EVENT_RX) == EVENT_RX);
+    CHECK(SREG == 0);
+
+    SREG = SREG_I;
+}
+
+static void testWaitPending(void)
+{
+    Event_GroupType group = EVENT_TICK | EVENT_DOOR;
+
+    /* Already pending: returns without sleeping and leaves the others */
+    g_sleeps = 0;
+    g_isrAt = 0;
+    CHECK(Event_wait(&group, EVENT_TICK | EVENT_RX) == EVENT_TICK);
+    CHECK(g_sleeps == 0);
+    CHECK(group == EVENT_DOOR);
+}
+
+static void testWaitSleeps(void)
+{
+    Event_GroupType group = EVENT_DOOR;
+
+    /* A flag outside the mask does not end the wait, the ISR's does */
+    g_sleeps = 0;
+    g_isrGroup = &group;
+    g_isrFlags = EVENT_RX;
+    g_isrAt = 5;
+    CHECK(Event_wait(&group, EVENT_RX | EVENT_TICK) == EVENT_RX);
+    CHECK(g_sleeps == 5);
+    CHECK(group == EVENT_DOOR);
+
+    /* Both raised on the same wake-up are taken together */
+    g_sleeps = 0;
+    g_isrFlags = EVENT_RX | EVENT_TICK;
+    g_isrAt = 1;
+    CHECK(Event_wait(&group, EVENT_RX | EVENT_TICK) == (EVENT_RX | EVENT_TICK));
+    CHECK(g_sleeps == 1);
+    CHECK(Event_take(&group, 0xFF) == EVENT_DOOR);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    SREG = SREG_I;
+
+    testTakeClearsOnlyMask();
+    testInterruptFlagRestored();
+    testWaitPending();
+    testWaitSleeps();
+
+    printf("event: %s\n", g_failures ? "FAIL" : "ok");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,217 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: pool_test.c
+ *
+ * Description: Unit tests for the fixed-block pools (Common/Common/pool.c):
+ *              exhaustion and reuse, the statistics, Pool_free refusing
+ *              foreign, misaligned and twice-freed blocks, and the dump.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "pool.h"
+#include "link.h"
+#include "protocol.h"
+#include <avr/io.h>
+#include <stdio.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #condition);        \
+            g_failures++;                                                       \
+        }                                                                       \
+    } while (0)
+
+#define SMALL_BLOCKS    3
+#define LARGE_BLOCKS    9       /* Two bytes of in-use bits */
+
+typedef struct {
+    uint8 bytes[6];
+} Block;
+
+POOL_DEFINE(g_small, Block, SMALL_BLOCKS);
+POOL_DEFINE(g_large, uint8, LARGE_BLOCKS);
+POOL_DEFINE(g_fresh, Block, 2);
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_failures = 0;
+
+static uint8 g_sent[64];     /* Payloads of the sent frames, back to back */
+static uint8 g_sentCount = 0;
+static uint8 g_frames = 0;
+static uint8 g_badFrames = 0;  /* Not RESPONSE_POOLS under the dump's number */
+
+/*******************************************************************************
+ *                                  Stubs                                      *
+ *******************************************************************************/
+
+/* Pool_dump is the only user of the link here */
+void Link_sendFrame(uint8 type, uint8 seq, const uint8 *payload, uint8 length)
+{
+    uint8 i;
+
+    if (type != RESPONSE_POOLS || seq != 0x42)
+    {
+        g_badFrames++;
+    }
+    for (i = 0; i < length; i++, g_sentCount++)
+    {
+        if (g_sentCount < sizeof(g_sent))
+        {
+            g_sent[g_sentCount] = payload[i];
+        }
+    }
+    g_frames++;
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void testExhaustAndReuse(void)
+{
+    Block *blocks[SMALL_BLOCKS], *block;
+    uint8 i;
+
+    for (i = 0; i < SMALL_BLOCKS; i++)
+    {
+        blocks[i] = Pool_alloc(&g_small);
+        CHECK(blocks[i] != NULL_PTR);
+        memset(blocks[i], 0xEE, sizeof(Block));     /* The whole block is the caller's */
+    }
+    CHECK(blocks[1] != blocks[0] && blocks[2] != blocks[1] && blocks[2] != blocks[0]);
+    CHECK(g_small.inUse == SMALL_BLOCKS && g_small.highWater == SMALL_BLOCKS);
+
+    /* All taken: refused and counted */
+    CHECK(Pool_alloc(&g_small) == NULL_PTR);
+    CHECK(Pool_alloc(&g_small) == NULL_PTR);
+    CHECK(g_small.failures == 2);
+
+    /* A freed block is handed out again, the last freed first */
+    CHECK(Pool_free(&g_small, blocks[1]));
+    CHECK(Pool_free(&g_small, blocks[0]));
+    CHECK(g_small.inUse == 1);
+    block = Pool_alloc(&g_small);
+    CHECK(block == blocks[0]);
+    block = Pool_alloc(&g_small);
+    CHECK(block == blocks[1]);
+    CHECK(Pool_alloc(&g_small) == NULL_PTR);
+    CHECK(g_small.highWater == SMALL_BLOCKS);
+
+    for (i = 0; i < SMALL_BLOCKS; i++)
+    {
+        CHECK(Pool_free(&g_small, blocks[i]));
+    }
+    CHECK(g_small.inUse == 0 && g_small.highWater == SMALL_BLOCKS);
+}
+
+static void testRejectedFrees(void)
+{
+    Block outside;
+    uint8 *block = Pool_alloc(&g_small);
+    uint8 *other = Pool_alloc(&g_large);
+
+    CHECK(block != NULL_PTR && other != NULL_PTR);
+
+    /* Not from this pool: another pool's block, a local, either end of the pool */
+    CHECK(!Pool_free(&g_small, other));
+    CHECK(!Pool_free(&g_small, &outside));
+    CHECK(!Pool_free(&g_small, g_small.blocks - g_small.blockSize));
+    CHECK(!Pool_free(&g_small, g_small.blocks + SMALL_BLOCKS * g_small.blockSize));
+
+    /* Inside a block rather than at its start */
+    CHECK(!Pool_free(&g_small, block + 1));
+    CHECK(g_small.inUse == 1);
+
+    /* Freed twice: the second is refused and the block is listed once */
+    CHECK(Pool_free(&g_small, block));
+    CHECK(!Pool_free(&g_small, block));
+    CHECK(g_small.inUse == 0);
+    CHECK(Pool_alloc(&g_small) == (void *)block);
+    CHECK(Pool_alloc(&g_small) != (void *)block);
+    CHECK(Pool_alloc(&g_small) != (void *)block);
+    CHECK(Pool_alloc(&g_small) == NULL_PTR);
+
+    CHECK(Pool_free(&g_large, other));
+}
+
+static void testLargeBitmap(void)
+{
+    uint8 *blocks[LARGE_BLOCKS];
+    uint8 i;
+
+    /* Blocks past the first eight use the second byte of in-use bits */
+    for (i = 0; i < LARGE_BLOCKS; i++)
+    {
+        blocks[i] = Pool_alloc(&g_large);
+        CHECK(blocks[i] != NULL_PTR);
+    }
+    CHECK(Pool_alloc(&g_large) == NULL_PTR);
+
+    CHECK(Pool_free(&g_large, blocks[8]));
+    CHECK(!Pool_free(&g_large, blocks[8]));
+    CHECK(Pool_free(&g_large, blocks[7]));
+    CHECK(!Pool_free(&g_large, blocks[7]));
+    CHECK(g_large.inUse == LARGE_BLOCKS - 2);
+    CHECK(Pool_alloc(&g_large) == blocks[7]);
+    CHECK(Pool_alloc(&g_large) == blocks[8]);
+}
+
+static void testNeverHandedOut(void)
+{
+    /* A block the fresh mark has not reached yet is not in use either */
+    CHECK(!Pool_free(&g_fresh, g_fresh.blocks));
+    CHECK(!Pool_free(&g_fresh, g_fresh.blocks + g_fresh.blockSize));
+    CHECK(g_fresh.inUse == 0);
+    CHECK(Pool_alloc(&g_fresh) == g_fresh.blocks);
+    CHECK(!Pool_free(&g_fresh, g_fresh.blocks + g_fresh.blockSize));
+}
+
+static void testDump(void)
+{
+    /* Pools are listed last-initialised first */
+    Pool_init(&g_small);
+    Pool_init(&g_large);
+    g_sentCount = 0;
+    Pool_dump(0x42);
+
+    CHECK(g_frames == 1 + 2 && g_badFrames == 0);
+    CHECK(g_sentCount == sizeof(Protocol_PoolHeaderType) + 2 * sizeof(Protocol_PoolStatsType));
+    CHECK(g_sent[0] == 2);
+    CHECK(g_sent[1] == g_large.blockSize && g_sent[2] == LARGE_BLOCKS);
+    CHECK(g_sent[3] == g_large.inUse && g_sent[4] == g_large.highWater && g_sent[5] == g_large.failures);
+    CHECK(g_sent[6] == g_small.blockSize && g_sent[7] == SMALL_BLOCKS);
+    CHECK(g_sent[8] == SMALL_BLOCKS && g_sent[9] == SMALL_BLOCKS && g_sent[10] == g_small.failures);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    SREG = 1 << 7;
+
+    testExhaustAndReuse();
+    testRejectedFrees();
+    testLargeBitmap();
+    testNeverHandedOut();
+    testDump();
+    CHECK(SREG == (1 << 7));
+
+    printf("pool: %s\n", g_failures ? "FAIL" : "ok");
+    return g_failures ? 1 : 0;
+}
@@ -0,0 +1,239 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: queue_bench.c
+ *
+ * Description: Cycle benchmark of the ISR to main loop hand-off: the SPSC
+ *              queue (queue.h) against a ring guarded by masking interrupts
+ *              as trace.c and pool.c do, and the event group (event.h)
+ *              against a volatile flag cleared with interrupts masked.
+ *
+ * Host cycles only rank the two ways on this CPU. Host cli() is a plain
+ * store to a variable, so the masked paths look cheaper here than on the
+ * AVR, where each costs the SREG save, CLI and restore.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "queue.h"
+#include "event.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <time.h>
+#if defined(__x86_64__) || defined(__i386__)
+#include <x86intrin.h>
+#endif
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define BATCH           64      /* Items per ISR burst, then drained by the loop */
+#define BURSTS          20000
+#define RUNS            15      /* Median of, against scheduler noise */
+
+#define RING_SIZE       128
+
+QUEUE_DEFINE(Bench, uint8, RING_SIZE)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static Bench_QueueType g_queue;
+
+/* The masked ring: one shared count both sides update with interrupts off */
+static uint8 g_ring[RING_SIZE];
+static uint8 g_ringHead = 0;
+static uint8 g_ringTail = 0;
+static volatile uint8 g_ringCount = 0;
+
+static Event_GroupType g_events;
+static volatile uint8 g_flag = FALSE;
+
+static volatile uint32 g_sink;
+
+/*******************************************************************************
+ *                                  Stubs                                      *
+ *******************************************************************************/
+
+void Idle_sleep(void)
+{
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static uint64_t cycles(void)
+{
+#if defined(__x86_64__) || defined(__i386__)
+    return __rdtsc();
+#else
+    struct timespec now;
+
+    clock_gettime(CLOCK_MONOTONIC, &now);
+    return (uint64_t)now.tv_sec * 1000000000u + (uint64_t)now.tv_nsec;
+#endif
+}
+
+/*---- ISR side runs unmasked in both: interrupts do not nest ----*/
+
+static void ringPushFromIsr(uint8 item)
+{
+    if (g_ringCount != RING_SIZE)
+    {
+        g_ring[g_ringHead] = item;
+        g_ringHead = (g_ringHead + 1) & (RING_SIZE - 1);
+        g_ringCount++;
+    }
+}
+
+static uint8 ringPop(uint8 *item)
+{
+    uint8 sreg = SREG;
+    uint8 popped = FALSE;
+
+    cli();
+    if (g_ringCount != 0)
+    {
+        *item = g_ring[g_ringTail];
+        g_ringTail = (g_ringTail + 1) & (RING_SIZE - 1);
+        g_ringCount--;
+        popped = TRUE;
+    }
+    SREG = sreg;
+
+    return popped;
+}
+
+static uint8 flagTake(void)
+{
+    uint8 sreg = SREG;
+    uint8 taken;
+
+    cli();
+    taken = g_flag;
+    g_flag = FALSE;
+    SREG = sreg;
+
+    return taken;
+}
+
+/*---- One run of each, cycles per item or per event ----*/
+
+static double runQueue(void)
+{
+    uint64_t start = cycles();
+    uint32 sum = 0;
+    uint8 item;
+    int burst, i;
+
+    for (burst = 0; burst < BURSTS; burst++)
+    {
+        for (i = 0; i < BATCH; i++)
+        {
+            Bench_push(&g_queue, (uint8)i);
+        }
+        while (Bench_pop(&g_queue, &item))
+        {
+            sum += item;
+        }
+    }
+    g_sink = sum;
+    return (double)(cycles() - start) / ((double)BURSTS * BATCH);
+}
+
+static double runRing(void)
+{
+    uint64_t start = cycles();
+    uint32 sum = 0;
+    uint8 item;
+    int burst, i;
+
+    for (burst = 0; burst < BURSTS; burst++)
+    {
+        for (i = 0; i < BATCH; i++)
+        {
+            ringPushFromIsr((uint8)i);
+        }
+        while (ringPop(&item))
+        {
+            sum += item;
+        }
+    }
+    g_sink = sum;
+    return (double)(cycles() - start) / ((double)BURSTS * BATCH);
+}
+
+static double runEvents(void)
+{
+    uint64_t start = cycles();
+    uint32 sum = 0;
+    long i;
+
+    for (i = 0; i < (long)BURSTS * BATCH; i++)
+    {
+        Event_setFromIsr(&g_events, 1 << (i & 7));
+        sum += Event_take(&g_events, 0xFF);
+    }
+    g_sink = sum;
+    return (double)(cycles() - start) / ((double)BURSTS * BATCH);
+}
+
+static double runFlag(void)
+{
+    uint64_t start = cycles();
+    uint32 sum = 0;
+    long i;
+
+    for (i = 0; i < (long)BURSTS * BATCH; i++)
+    {
+        g_flag = TRUE;
+        sum += flagTake();
+    }
+    g_sink = sum;
+    return (double)(cycles() - start) / ((double)BURSTS * BATCH);
+}
+
+static int compareDouble(const void *a, const void *b)
+{
+    double x = *(const double *)a, y = *(const double *)b;
+
+    return (x > y) - (x < y);
+}
+
+static double median(double (*run)(void))
+{
+    double samples[RUNS];
+    int i;
+
+    for (i = 0; i < RUNS; i++)
+    {
+        samples[i] = run();
+    }
+    qsort(samples, RUNS, sizeof(samples[0]), compareDouble);
+    return samples[RUNS / 2];
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    SREG = 1 << 7;
+
+#if defined(__x86_64__) || defined(__i386__)
+    printf("# host TSC cycles per item, median of %d runs of %d bursts of %d\n", RUNS, BURSTS, BATCH);
+#else
+    printf("# host ns per item, median of %d runs of %d bursts of %d\n", RUNS, BURSTS, BATCH);
+#endif
+    printf("queue push+pop        %6.2f\n", median(runQueue));
+    printf("masked ring push+pop  %6.2f\n", median(runRing));
+    printf("event set+take        %6.2f\n", median(runEvents));
+    printf("masked flag set+take  %6.2f\n", median(runFlag));
+    return 0;
+}
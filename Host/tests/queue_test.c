@@ -0,0 +1,195 @@
+/******************************************************************************
+ *
+ * Module: Host Tests
+ *
+ * File Name: queue_test.c
+ *
+ * Description: Unit tests for the SPSC ring queue (Common/Common/queue.h):
+ *              empty and full, wrap-around of the free-running indices, and
+ *              one producer and one consumer thread passing a long sequence
+ *              through a small queue.
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include "queue.h"
+#include <pthread.h>
+#include <sched.h>
+#include <stdio.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+#define CHECK(condition)                                                        \
+    do {                                                                        \
+        if (!(condition))                                                       \
+        {                                                                       \
+            printf("FAIL: %s:%d: %s\n", __FILE__, __LINE__, #condition);        \
+            g_failures++;                                                       \
+        }                                                                       \
+    } while (0)
+
+#define STRESS_ITEMS    200000UL
+
+typedef struct {
+    uint16 value;
+    uint8 tag;
+} Item;
+
+QUEUE_DEFINE(Byte, uint8, 8)
+QUEUE_DEFINE(Item, Item, 4)
+QUEUE_DEFINE(Word, uint32, 16)
+QUEUE_DEFINE(Largest, uint8, QUEUE_MAX_CAPACITY)
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static int g_failures = 0;
+static Word_QueueType g_stress;
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static void testEmptyAndFull(void)
+{
+    Byte_QueueType queue = { 0 };
+    uint8 item = 0xA5, i;
+
+    /* Zero-initialised is empty, a failed pop leaves the item alone */
+    CHECK(Byte_count(&queue) == 0);
+    CHECK(!Byte_pop(&queue, &item));
+    CHECK(item == 0xA5);
+
+    for (i = 0; i < 8; i++)
+    {
+        CHECK(Byte_push(&queue, i));
+    }
+    CHECK(Byte_count(&queue) == 8);
+    CHECK(!Byte_push(&queue, 99));      /* Full: dropped */
+    CHECK(Byte_count(&queue) == 8);
+
+    for (i = 0; i < 8; i++)
+    {
+        CHECK(Byte_pop(&queue, &item) && item == i);
+    }
+    CHECK(!Byte_pop(&queue, &item));
+    CHECK(Byte_count(&queue) == 0);
+}
+
+static void testWrapAround(void)
+{
+    Item_QueueType queue = { 0 };
+    Item item = { 0, 0 };
+    uint16 pushed = 0, popped = 0;
+    int round;
+
+    /* Far past the 8-bit index wrap, at every fill level from 1 to full */
+    for (round = 0; round < 1000; round++)
+    {
+        uint8 fill = (uint8)(round % 4 + 1), i;
+
+        for (i = 0; i < fill; i++)
+        {
+            item.value = pushed;
+            item.tag = (uint8)~pushed;
+            CHECK(Item_push(&queue, item));
+            pushed++;
+        }
+        CHECK(Item_count(&queue) == fill);
+        CHECK(fill < 4 || !Item_push(&queue, item));
+        for (i = 0; i < fill; i++)
+        {
+            CHECK(Item_pop(&queue, &item));
+            CHECK(item.value == popped && item.tag == (uint8)~popped);
+            popped++;
+        }
+    }
+    CHECK(queue.head == (uint8)pushed && queue.tail == (uint8)popped);
+}
+
+static void testLargestCapacity(void)
+{
+    Largest_QueueType queue = { 0 };
+    uint8 item;
+    int i, round;
+
+    /* head - tail must still tell 128 items from none after the indices wrap */
+    for (round = 0; round < 3; round++)
+    {
+        for (i = 0; i < QUEUE_MAX_CAPACITY; i++)
+        {
+            CHECK(Largest_push(&queue, (uint8)i));
+        }
+        CHECK(Largest_count(&queue) == QUEUE_MAX_CAPACITY);
+        CHECK(!Largest_push(&queue, 0));
+        for (i = 0; i < QUEUE_MAX_CAPACITY; i++)
+        {
+            CHECK(Largest_pop(&queue, &item) && item == (uint8)i);
+        }
+        CHECK(!Largest_pop(&queue, &item));
+    }
+}
+
+/*
+ * The producer stands in for an ISR. Either side yields when it has to wait,
+ * so the test also finishes quickly on a single CPU.
+ */
+static void *stressProducer(void *unused)
+{
+    uint32 value;
+
+    (void)unused;
+    for (value = 0; value < STRESS_ITEMS; value++)
+    {
+        while (!Word_push(&g_stress, value))
+        {
+            sched_yield();
+        }
+    }
+    return NULL;
+}
+
+static void testConcurrent(void)
+{
+    pthread_t producer;
+    uint32 expected = 0, item;
+
+    pthread_create(&producer, NULL, stressProducer, NULL);
+    while (expected < STRESS_ITEMS)
+    {
+        if (Word_pop(&g_stress, &item))
+        {
+            if (item != expected)
+            {
+                printf("FAIL: concurrent: got %lu, expected %lu\n", (unsigned long)item, (unsigned long)expected);
+                g_failures++;
+                break;
+            }
+            expected++;
+        }
+        else
+        {
+            sched_yield();
+        }
+    }
+    pthread_join(producer, NULL);
+}
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+int main(void)
+{
+    testEmptyAndFull();
+    testWrapAround();
+    testLargestCapacity();
+    testConcurrent();
+
+    printf("queue: %s\n", g_failures ? "FAIL" : "ok");
+    return g_failures ? 1 : 0;
+}
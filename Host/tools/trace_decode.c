@@ -0,0 +1,200 @@
+/******************************************************************************
+ *
+ * Module: Trace Decoder
+ *
+ * File Name: trace_decode.c
+ *
+ * Description: Turns a trace dump (Common/Common/trace.h) into a timeline.
+ *              The dump is read from a file, a serial device set up with
+ *              stty, or stdin; bytes before its first RESPONSE_TRACE frame
+ *              are skipped, so a capture of the live link works too.
+ *
+ *              trace_decode [dump file | /dev/ttyUSB0]
+ *
+ * Author: Mostafa Hatem
+ *
+ *******************************************************************************/
+
+#include <stdio.h>
+#include <stdlib.h>
+#include "trace.h"
+#include "link.h"
+#include "protocol.h"
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+static const uint32 Link_baudRates[LINK_NUM_BAUD_RATES] = LINK_BAUD_RATES;
+
+static const char *const Trace_eventNames[TRACE_NUM_EVENTS] = {
+    [TRACE_BOOT]         = "BOOT",
+    [TRACE_UART_TX]      = "UART_TX",
+    [TRACE_UART_RX]      = "UART_RX",
+    [TRACE_COMMAND]      = "COMMAND",
+    [TRACE_STATE]        = "STATE",
+    [TRACE_UNEXPECTED]   = "UNEXPECTED",
+    [TRACE_EEPROM_ERROR] = "EEPROM_ERROR",
+    [TRACE_LOCKOUT]      = "LOCKOUT",
+    [TRACE_FAULT]        = "FAULT",
+    [TRACE_LINK_RATE]    = "LINK_RATE",
+    [TRACE_RETRY]        = "RETRY",
+    [TRACE_RESYNC]       = "RESYNC",
+    [TRACE_DOOR_EDGE]    = "DOOR_EDGE",
+};
+
+#define PROTOCOL_NAME_ENTRY(name, code, payload, minLength)     [code] = #name,
+
+static const char *const Protocol_names[256] = {
+    PROTOCOL_COMMANDS(PROTOCOL_NAME_ENTRY)
+    PROTOCOL_RESPONSES(PROTOCOL_NAME_ENTRY)
+    PROTOCOL_EVENTS(PROTOCOL_NAME_ENTRY)
+};
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+
+static int Trace_readByte(FILE *in)
+{
+    int c = fgetc(in);
+
+    if (c == EOF)
+    {
+        fprintf(stderr, "trace_decode: dump truncated\n");
+        exit(1);
+    }
+    return c;
+}
+
+static void Trace_printArgs(uint8 event, uint8 arg0, uint8 arg1)
+{
+    switch (event)
+    {
+    case TRACE_UART_TX:
+    case TRACE_UART_RX:
+        printf("0x%02X", arg0);
+        break;
+    case TRACE_COMMAND:
+        printf("0x%02X %s seq %u", arg0, Protocol_names[arg0] ? Protocol_names[arg0] : "?", arg1);
+        break;
+    case TRACE_STATE:
+        printf("%u", arg0);
+        break;
+    case TRACE_UNEXPECTED:
+        printf("expected 0x%02X got 0x%02X", arg0, arg1);
+        break;
+    case TRACE_EEPROM_ERROR:
+        printf("storage key %u", arg0);
+        break;
+    case TRACE_LOCKOUT:
+        printf("%us", arg0);
+        break;
+    case TRACE_FAULT:
+        printf("code %u", arg0);
+        break;
+    case TRACE_DOOR_EDGE:
+        printf("%s", arg0 ? "closed" : "open");
+        break;
+    case TRACE_LINK_RATE:
+        printf("%lu baud", (arg0 < LINK_NUM_BAUD_RATES) ? (unsigned long)Link_baudRates[arg0] : 0UL);
+        break;
+    default:
+        break;
+    }
+}
+
+/*******************************************************************************
+ *                           Main Function                                     *
+ *******************************************************************************/
+
+int main(int argc, char *argv[])
+{
+    FILE *in = stdin;
+    uint8 count, i, event, arg0, arg1;
+    uint8 payload[LINK_MAX_PAYLOAD], length = 0, used = 0;
+    uint16 total, time, last_time = 0;
+    uint32 elapsed = 0;
+    int c, previous[2] = { EOF, EOF };
+
+    if (argc > 2)
+    {
+        fprintf(stderr, "usage: %s [dump file]\n", argv[0]);
+        return 2;
+    }
+    if (argc == 2 && (in = fopen(argv[1], "rb")) == NULL)
+    {
+        perror(argv[1]);
+        return 1;
+    }
+
+    /* The header frame: RESPONSE_TRACE, any sequence number, the header length */
+    while ((c = fgetc(in)) != EOF
+            && !(previous[0] == RESPONSE_TRACE && c == sizeof(Protocol_TraceHeaderType)))
+    {
+        previous[0] = previous[1];
+        previous[1] = c;
+    }
+    if (c == EOF)
+    {
+        fprintf(stderr, "trace_decode: no dump found\n");
+        return 1;
+    }
+
+    count = (uint8)Trace_readByte(in);
+    total = (uint16)Trace_readByte(in);
+    total |= (uint16)(Trace_readByte(in) << 8);
+    printf("%u records, %u lost before the oldest\n", count, (uint16)(total - count));
+    printf("%10s %8s  %-13s %s\n", "ms", "+ms", "event", "args");
+
+    for (i = 0; i < count; i++)
+    {
+        /* The records come PROTOCOL_TRACE_RECORDS to a frame */
+        if (used == length)
+        {
+            if (Trace_readByte(in) != RESPONSE_TRACE)
+            {
+                fprintf(stderr, "trace_decode: dump cut by another frame\n");
+                return 1;
+            }
+            (void)Trace_readByte(in);
+            length = (uint8)Trace_readByte(in);
+            if (length == 0 || length > sizeof(payload) || length % PROTOCOL_TRACE_RECORD_SIZE != 0)
+            {
+                fprintf(stderr, "trace_decode: bad frame length %u\n", length);
+                return 1;
+            }
+            for (used = 0; used < length; used++)
+            {
+                payload[used] = (uint8)Trace_readByte(in);
+            }
+            used = 0;
+        }
+
+        time = (uint16)(payload[used] | (payload[used + 1] << 8));
+        event = payload[used + 2];
+        arg0 = payload[used + 3];
+        arg1 = payload[used + 4];
+        used += PROTOCOL_TRACE_RECORD_SIZE;
+
+        /* The 16-bit timestamp wraps every 65.5s, records are in order */
+        if (i > 0)
+        {
+            elapsed += (uint16)(time - last_time);
+        }
+        printf("%10lu %8u  ", (unsigned long)elapsed, (i > 0) ? (uint16)(time - last_time) : 0);
+        last_time = time;
+
+        if (event < TRACE_NUM_EVENTS && Trace_eventNames[event] != NULL)
+        {
+            printf("%-13s ", Trace_eventNames[event]);
+        }
+        else
+        {
+            printf("EVENT_%-7u ", event);
+        }
+        Trace_printArgs(event, arg0, arg1);
+        putchar('\n');
+    }
+    return 0;
+}